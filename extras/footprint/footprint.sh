@@ -0,0 +1,255 @@
+#!/bin/sh
+#
+# Reports the flash, SRAM and stack usage of representative sketches
+# that use each part of the Arduboy2EEPROM API, and fails if any of
+# them has grown since the usage recorded in the baseline.
+#
+# Usage:
+#   footprint.sh [--host] [--update | --against REVISION]
+#
+#   --host      Build for the host instead of the AVR, using the stand-in
+#               avr-libc headers in extras/host, and use baseline-host.txt
+#               instead of baseline.txt. Host figures are not those of an
+#               Arduboy, but still reveal growth where avr-gcc is unavailable.
+#   --update    Record the results as the baseline instead of comparing.
+#   --against REVISION
+#               Instead of a recorded baseline, build the sources and
+#               sketches of a git revision (e.g. origin/main) with the same
+#               compiler, and compare against those. This is how the AVR
+#               gate is run in CI, since it needs no recorded figures.
+#
+# A missing baseline is an error unless --update or --against is given.
+#
+# Each baseline records the compiler that produced it on its first line,
+# and comparing with a different compiler is an error, since figures
+# change from one compiler version to another. baseline-host.txt was
+# recorded with Debian's g++ 12.2.0 for x86-64; with any other host
+# compiler, use --against, or --update to record a baseline of your own.
+#
+# Environment:
+#   AVR_CXX   The compiler to use (default: avr-g++)
+#   AVR_NM    The symbol lister to use (default: avr-nm)
+#   AVR_SIZE  The size reporter to use (default: avr-size)
+#   MCU       The target device (default: atmega32u4, as used by the Arduboy)
+#   HOST_CXX, HOST_NM, HOST_SIZE
+#             The tools to use with --host (default: c++, nm, size)
+#
+# For each sketch in sketches/, the report lists the size of every
+# function linked into the program and the stack frame of every function
+# compiled from the sketch, along with the sketch's totals. Sketches are
+# compared against Empty.cpp, so the totals show what the API costs
+# on top of the program's startup code.
+#
+# The stack figure compared against the baseline is the largest single
+# frame, since a sketch's total stack depth depends on its call graph.
+#
+# LTO is deliberately not used, as it prevents -fstack-usage
+# from attributing frames to the functions in the source.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+build="$here/build"
+
+host=0
+update=0
+against=""
+
+usage()
+{
+	echo "usage: $0 [--host] [--update | --against REVISION]" >&2
+	exit 2
+}
+
+while [ "$#" -gt 0 ]
+do
+	case "$1" in
+		--host)
+			host=1
+			;;
+		--update)
+			update=1
+			;;
+		--against)
+			[ "$#" -ge 2 ] || usage
+			against=$2
+			shift
+			;;
+		*)
+			usage
+			;;
+	esac
+
+	shift
+done
+
+if [ "$update" -eq 1 ] && [ -n "$against" ]
+then
+	usage
+fi
+
+if [ "$host" -eq 1 ]
+then
+	CXX=${HOST_CXX:-c++}
+	NM=${HOST_NM:-nm}
+	SIZE=${HOST_SIZE:-size}
+	targetFlags="-I$here/../host"
+	baseline="$here/baseline-host.txt"
+else
+	CXX=${AVR_CXX:-avr-g++}
+	NM=${AVR_NM:-avr-nm}
+	SIZE=${AVR_SIZE:-avr-size}
+	targetFlags="-mmcu=${MCU:-atmega32u4}"
+	baseline="$here/baseline.txt"
+fi
+
+if ! command -v "$CXX" > /dev/null
+then
+	echo "$CXX was not found; install it, or use --host to measure with the host compiler" >&2
+	exit 1
+fi
+
+compiler="# $("$CXX" --version | head -n 1)"
+
+# Builds every sketch in a directory against a source directory,
+# appending 'name flash sram stack' lines to a summary file.
+# The detailed report is printed only if the fourth argument is 1.
+measure()
+{
+	# sh has no local variables, so these are named apart from the globals
+	measuredSources=$1
+	measuredSketches=$2
+	measuredSummary=$3
+	report=$4
+	output=$(dirname "$measuredSummary")
+
+	echo "$compiler" > "$measuredSummary"
+
+	for sketch in "$measuredSketches"/*.cpp
+	do
+		name=$(basename "$sketch" .cpp)
+		object="$output/$name.o"
+		program="$output/$name.elf"
+
+		# The flags used by the Arduino IDE for AVR boards
+		"$CXX" $targetFlags -std=gnu++11 -Os -fno-exceptions -fno-threadsafe-statics \
+			-ffunction-sections -fdata-sections -fstack-usage \
+			-I"$measuredSources" -c "$sketch" -o "$object"
+
+		"$CXX" $targetFlags -Os -Wl,--gc-sections "$object" -o "$program"
+
+		# Berkeley format gives text, data and bss on the second line.
+		# Flash holds text and data, whilst SRAM holds data and bss.
+		sizes=$("$SIZE" --format=berkeley "$program" | awk 'NR == 2 { print $1 + $2, $2 + $3 }')
+		flash=${sizes% *}
+		sram=${sizes#* }
+
+		# Each line of a .su file is 'file:line:column:function<TAB>bytes<TAB>kind'
+		stack=$(awk -F '\t' 'BEGIN { largest = 0 } $2 > largest { largest = $2 } END { print largest }' "$output/$name.su")
+
+		if [ "$report" -eq 1 ]
+		then
+			echo "== $name: $flash bytes of flash, $sram bytes of SRAM, largest frame $stack bytes"
+			echo
+			echo "Functions (bytes of flash):"
+			# With --size-sort, each line is 'size type name', and template
+			# instantiations are weak symbols, thus of type 'W' rather than 'T'
+			"$NM" --size-sort --radix=d --demangle "$program" | awk '$2 ~ /^[TtWw]$/ { size = $1 + 0; $1 = $2 = ""; sub(/^ +/, ""); printf "%8d  %s\n", size, $0 }'
+			echo
+			echo "Stack frames (bytes):"
+			awk -F '\t' '{ sub(/^[^:]*:[0-9]+:[0-9]+:/, "", $1); printf "%8d  %s (%s)\n", $2, $1, $3 }' "$output/$name.su" | sort -rn
+			echo
+		fi
+
+		echo "$name $flash $sram $stack" >> "$measuredSummary"
+	done
+}
+
+rm -rf "$build"
+mkdir -p "$build/current"
+
+summary="$build/current/summary.txt"
+measure "$here/../../src" "$here/sketches" "$summary" 1
+
+# Report the cost of each sketch over the empty sketch
+empty=$(awk '$1 == "Empty"' "$summary")
+
+if [ -n "$empty" ]
+then
+	echo "== Cost over Empty (flash, SRAM):"
+	echo "$empty" | {
+		read -r _ emptyFlash emptySram _
+		while read -r name flash sram _
+		do
+			[ "$name" = "#" ] && continue
+			[ "$name" = "Empty" ] && continue
+			printf "%8d %8d  %s\n" $((flash - emptyFlash)) $((sram - emptySram)) "$name"
+		done < "$summary"
+	}
+	echo
+fi
+
+if [ "$update" -eq 1 ]
+then
+	cp "$summary" "$baseline"
+	echo "Recorded the baseline in $baseline"
+	exit 0
+fi
+
+if [ -n "$against" ]
+then
+	# The sketches of the revision are used, since they can only
+	# use the parts of the API that the revision provides
+	reference="$build/reference"
+	mkdir -p "$reference/output"
+
+	top=$(git -C "$here" rev-parse --show-toplevel)
+	git -C "$top" archive "$against" src extras/footprint/sketches | tar -x -C "$reference"
+
+	baseline="$reference/output/summary.txt"
+	measure "$reference/src" "$reference/extras/footprint/sketches" "$baseline" 0
+fi
+
+if [ ! -f "$baseline" ]
+then
+	echo "No baseline to compare against in $baseline; run with --update to record one, or with --against to compare with a revision" >&2
+	exit 1
+fi
+
+recorded=$(head -n 1 "$baseline")
+
+if [ "$recorded" != "$compiler" ]
+then
+	echo "The baseline in $baseline was recorded with '${recorded#\# }', but '${compiler#\# }' is in use; use --against, or --update to record a new baseline" >&2
+	exit 1
+fi
+
+status=0
+
+while read -r name flash sram stack
+do
+	[ "$name" = "#" ] && continue
+
+	previous=$(awk -v name="$name" '$1 == name' "$baseline")
+
+	if [ -z "$previous" ]
+	then
+		echo "$name: not in the baseline"
+		continue
+	fi
+
+	set -- $previous
+
+	if [ "$flash" -gt "$2" ] || [ "$sram" -gt "$3" ] || [ "$stack" -gt "$4" ]
+	then
+		echo "$name: regressed from $2 flash, $3 SRAM, $4 stack to $flash flash, $sram SRAM, $stack stack"
+		status=1
+	fi
+done < "$summary"
+
+if [ "$status" -eq 0 ]
+then
+	echo "No regressions against ${against:-$baseline}"
+fi
+
+exit "$status"
@@ -0,0 +1,9 @@
+// Empty.cpp
+// Uses nothing but begin(), providing the baseline
+// against which the other sketches are compared.
+#include <Arduboy2EEPROM.h>
+
+int main()
+{
+	Arduboy2EEPROM::begin();
+}
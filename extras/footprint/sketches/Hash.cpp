@@ -0,0 +1,31 @@
+// Hash.cpp
+// Hashes objects of each specialised size, an object of any other size,
+// a range of bytes, and a range of bytes stored in EEPROM.
+#include <Arduboy2EEPROM.h>
+
+struct Save
+{
+	uint16_t score;
+	uint8_t level;
+	uint8_t lives[5];
+};
+
+// Volatile, so that no call can be evaluated at compile time
+// and no result can be discarded
+volatile uintptr_t address;
+volatile uint32_t value;
+
+int main()
+{
+	Arduboy2EEPROM::begin();
+
+	const Save save { static_cast<uint16_t>(value), 1, { 2, 3, 4, 5, 6 } };
+	const unsigned char bytes[3] { 7, 8, 9 };
+
+	value = Arduboy2EEPROM::hash(static_cast<uint8_t>(value));
+	value = Arduboy2EEPROM::hash(static_cast<uint16_t>(value));
+	value = Arduboy2EEPROM::hash(static_cast<uint32_t>(value));
+	value = Arduboy2EEPROM::hash(save);
+	value = Arduboy2EEPROM::hash(bytes, sizeof(bytes));
+	value = Arduboy2EEPROM::hashStored(address, sizeof(save));
+}
@@ -0,0 +1,37 @@
+// Read.cpp
+// Reads a single byte, objects of each specialised size,
+// an object of any other size, and a range of bytes.
+#include <Arduboy2EEPROM.h>
+
+struct Save
+{
+	uint16_t score;
+	uint8_t level;
+	uint8_t lives[5];
+};
+
+// Volatile, so that no call can be evaluated at compile time
+// and no result can be discarded
+volatile uintptr_t address;
+volatile uint32_t value;
+
+int main()
+{
+	Arduboy2EEPROM::begin();
+
+	uint8_t byteValue;
+	uint16_t wordValue;
+	uint32_t dwordValue;
+	Save save;
+	unsigned char bytes[3];
+
+	value = Arduboy2EEPROM::readByte(address);
+
+	Arduboy2EEPROM::read(address, byteValue);
+	Arduboy2EEPROM::read(address, wordValue);
+	Arduboy2EEPROM::read(address, dwordValue);
+	Arduboy2EEPROM::read(address, save);
+	Arduboy2EEPROM::read(address, bytes, sizeof(bytes));
+
+	value = (byteValue + wordValue + dwordValue + save.score + bytes[0]);
+}
@@ -0,0 +1,30 @@
+// Write.cpp
+// Writes a single byte, objects of each specialised size,
+// an object of any other size, and a range of bytes.
+#include <Arduboy2EEPROM.h>
+
+struct Save
+{
+	uint16_t score;
+	uint8_t level;
+	uint8_t lives[5];
+};
+
+// Volatile, so that no call can be evaluated at compile time
+volatile uintptr_t address;
+volatile uint32_t value;
+
+int main()
+{
+	Arduboy2EEPROM::begin();
+
+	const Save save { static_cast<uint16_t>(value), 1, { 2, 3, 4, 5, 6 } };
+	const unsigned char bytes[3] { 7, 8, 9 };
+
+	Arduboy2EEPROM::writeByte(address, static_cast<unsigned char>(value));
+	Arduboy2EEPROM::write(address, static_cast<uint8_t>(value));
+	Arduboy2EEPROM::write(address, static_cast<uint16_t>(value));
+	Arduboy2EEPROM::write(address, static_cast<uint32_t>(value));
+	Arduboy2EEPROM::write(address, save);
+	Arduboy2EEPROM::write(address, bytes, sizeof(bytes));
+}
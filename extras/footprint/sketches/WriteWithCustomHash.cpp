@@ -0,0 +1,39 @@
+// WriteWithCustomHash.cpp
+// Writes and reads an object with a custom 8-bit hash.
+#include <Arduboy2EEPROM.h>
+
+struct Save
+{
+	uint16_t score;
+	uint8_t level;
+	uint8_t lives[5];
+};
+
+// Volatile, so that no call can be evaluated at compile time
+// and no result can be discarded
+volatile uintptr_t address;
+volatile uint32_t value;
+
+uint8_t checksum(const Save & save)
+{
+	const unsigned char * bytes = reinterpret_cast<const unsigned char *>(&save);
+
+	uint8_t result = 0;
+
+	for(size_t index = 0; index < sizeof(save); ++index)
+		result += bytes[index];
+
+	return result;
+}
+
+int main()
+{
+	Arduboy2EEPROM::begin();
+
+	Save save { static_cast<uint16_t>(value), 1, { 2, 3, 4, 5, 6 } };
+
+	Arduboy2EEPROM::writeWithHash(address, save, checksum);
+
+	if(Arduboy2EEPROM::readWithHash(address, save, checksum))
+		value = save.score;
+}
@@ -0,0 +1,27 @@
+// WriteWithHash.cpp
+// Writes and reads an object with the default hash.
+#include <Arduboy2EEPROM.h>
+
+struct Save
+{
+	uint16_t score;
+	uint8_t level;
+	uint8_t lives[5];
+};
+
+// Volatile, so that no call can be evaluated at compile time
+// and no result can be discarded
+volatile uintptr_t address;
+volatile uint32_t value;
+
+int main()
+{
+	Arduboy2EEPROM::begin();
+
+	Save save { static_cast<uint16_t>(value), 1, { 2, 3, 4, 5, 6 } };
+
+	Arduboy2EEPROM::writeWithHash(address, save);
+
+	if(Arduboy2EEPROM::readWithHash(address, save))
+		value = save.score;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+// A stand-in for avr-libc's <avr/eeprom.h>, for building on a host.
+// Only the functions that the library uses are provided.
+//
+// EEPROM is emulated by an array in RAM, which starts out erased.
+// As on the AVR, addresses wrap around at the end of EEPROM.
+// Every byte that is programmed is counted, so that simulations can
+// measure wear, and the image can be modified directly to inject faults.
+// A loss of power can be simulated by limiting the number of bytes
+// that may be programmed, after which programming has no effect.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(HOST_EEPROM_CAPACITY)
+#define HOST_EEPROM_CAPACITY 1024
+#endif
+
+struct HostEEPROM
+{
+	unsigned char image[HOST_EEPROM_CAPACITY];
+
+	// The number of times a byte has been programmed
+	uint32_t programCount;
+
+	// Once programCount reaches this, bytes are no longer programmed,
+	// as though power had been lost
+	uint32_t programLimit;
+
+	HostEEPROM() :
+		programCount(0), programLimit(UINT32_MAX)
+	{
+		memset(image, 0xFF, sizeof(image));
+	}
+};
+
+inline HostEEPROM & hostEEPROM()
+{
+	static HostEEPROM eeprom;
+	return eeprom;
+}
+
+inline unsigned char & hostEEPROMByte(uintptr_t address)
+{
+	return hostEEPROM().image[address % HOST_EEPROM_CAPACITY];
+}
+
+// Determines whether a byte may be programmed, and counts it if so
+inline bool hostEEPROMProgram()
+{
+	HostEEPROM & eeprom = hostEEPROM();
+
+	if(eeprom.programCount >= eeprom.programLimit)
+		return false;
+
+	++eeprom.programCount;
+	return true;
+}
+
+inline uint8_t eeprom_read_byte(const uint8_t * pointer)
+{
+	return hostEEPROMByte(reinterpret_cast<uintptr_t>(pointer));
+}
+
+inline void eeprom_write_byte(uint8_t * pointer, uint8_t value)
+{
+	if(hostEEPROMProgram())
+		hostEEPROMByte(reinterpret_cast<uintptr_t>(pointer)) = value;
+}
+
+inline void eeprom_update_byte(uint8_t * pointer, uint8_t value)
+{
+	if(eeprom_read_byte(pointer) != value)
+		eeprom_write_byte(pointer, value);
+}
+
+#define eeprom_is_ready() 1
+#define eeprom_busy_wait() do {} while(0)
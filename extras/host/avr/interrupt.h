@@ -0,0 +1,12 @@
+#pragma once
+
+// A stand-in for avr-libc's <avr/interrupt.h>, for building on a host,
+// where there are no interrupts to disable.
+
+inline void cli()
+{
+}
+
+inline void sei()
+{
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// A stand-in for avr-libc's <avr/io.h>, for building on a host.
+//
+// Only the EEPROM registers and SREG are provided.
+// Setting EEPE in EECR programs the byte at EEAR with EEDR,
+// honouring the programming mode selected by EEPM1 and EEPM0:
+// erase and write, erase only, or write only (which can only clear bits).
+// Each byte programmed is counted, and limited, as by <avr/eeprom.h>.
+
+#include <stdint.h>
+
+#include <avr/eeprom.h>
+
+#define EERE 0
+#define EEPE 1
+#define EEMPE 2
+#define EERIE 3
+#define EEPM0 4
+#define EEPM1 5
+
+struct HostEEPROMControlRegister
+{
+	uint8_t value;
+
+	HostEEPROMControlRegister & operator=(uint8_t newValue);
+
+	HostEEPROMControlRegister & operator|=(uint8_t bits)
+	{
+		return (*this = static_cast<uint8_t>(value | bits));
+	}
+
+	operator uint8_t() const
+	{
+		return value;
+	}
+};
+
+struct HostRegisters
+{
+	uint8_t sreg;
+	uint16_t eear;
+	uint8_t eedr;
+	HostEEPROMControlRegister eecr;
+};
+
+inline HostRegisters & hostRegisters()
+{
+	static HostRegisters registers {};
+	return registers;
+}
+
+inline HostEEPROMControlRegister & HostEEPROMControlRegister::operator=(uint8_t newValue)
+{
+	value = newValue;
+
+	if((value & (1 << EEPE)) == 0)
+		return *this;
+
+	const HostRegisters & registers = hostRegisters();
+	unsigned char & byte = hostEEPROMByte(registers.eear);
+
+	if(hostEEPROMProgram())
+	{
+		switch(value & ((1 << EEPM1) | (1 << EEPM0)))
+		{
+			case 0:
+				byte = registers.eedr;
+				break;
+
+			case (1 << EEPM0):
+				byte = 0xFF;
+				break;
+
+			case (1 << EEPM1):
+				byte &= registers.eedr;
+				break;
+		}
+	}
+
+	// Programming completes instantly
+	value = static_cast<uint8_t>(value & ~((1 << EEPE) | (1 << EEMPE)));
+
+	return *this;
+}
+
+#define SREG (hostRegisters().sreg)
+#define EEAR (hostRegisters().eear)
+#define EEDR (hostRegisters().eedr)
+#define EECR (hostRegisters().eecr)
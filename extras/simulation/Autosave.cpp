@@ -0,0 +1,148 @@
+// Autosave.cpp
+// Drives an Arduboy2EEPROMAutosave with a frame clock and checks that:
+//
+// - A burst of changes is saved once, a quiet period after the last change.
+// - A record that changes every frame is still saved within the maximum
+//   delay (plus one frame, since update() is only called once per frame).
+// - Times that wrap around are handled like any others.
+// - flush() saves a dirty record at once.
+//
+// Every saved record must load with readWithHash(),
+// and hold the object as it was when it was saved.
+#include <Arduboy2EEPROM.h>
+#include <Arduboy2EEPROMAutosave.h>
+
+#include <stdio.h>
+
+using EEPROM = Arduboy2EEPROM;
+using Autosave = Arduboy2EEPROMAutosave<EEPROM>;
+
+constexpr Autosave::TimeType frameTime = 16;
+constexpr Autosave::TimeType quietPeriod = 1000;
+constexpr Autosave::TimeType maximumDelay = 5000;
+
+constexpr uintptr_t saveAddress = 100;
+
+struct Save
+{
+	uint32_t score;
+	uint16_t level;
+};
+
+bool failed = false;
+
+void check(bool condition, const char * description, uint32_t value)
+{
+	if(condition)
+		return;
+
+	printf("%s failed at %u\n", description, static_cast<unsigned>(value));
+	failed = true;
+}
+
+bool isSaved(const Save & save)
+{
+	Save loaded {};
+	return (EEPROM::readWithHash(saveAddress, loaded) && (loaded.score == save.score) && (loaded.level == save.level));
+}
+
+// Changes the save every frame for a while, then leaves it alone
+void checkBurst(Autosave::TimeType start)
+{
+	hostEEPROM() = HostEEPROM();
+
+	Save save {};
+	Autosave autosave(quietPeriod, maximumDelay);
+	autosave.add(saveAddress, save);
+
+	constexpr size_t changes = 30;
+
+	Autosave::TimeType now = start;
+	Autosave::TimeType lastChange = start;
+
+	for(size_t frame = 0; frame < (changes + ((quietPeriod / frameTime) * 2)); ++frame, now += frameTime)
+	{
+		if(frame < changes)
+		{
+			save.score += 10;
+			autosave.markDirty(0, now);
+			lastChange = now;
+		}
+
+		if(autosave.update(now))
+		{
+			check((now - lastChange) >= quietPeriod, "waiting for the quiet period", start);
+			check((now - lastChange) < (quietPeriod + frameTime), "saving once the quiet period ends", start);
+		}
+	}
+
+	check(autosave.performedWrites() == 1, "saving a burst once", start);
+	check(autosave.absorbedWrites() == (changes - 1), "absorbing the rest of the burst", start);
+	check(isSaved(save), "loading the burst", start);
+
+	printf("Burst of %zu changes from %u: %u saves, %u absorbed\n", changes, static_cast<unsigned>(start),
+		static_cast<unsigned>(autosave.performedWrites()), static_cast<unsigned>(autosave.absorbedWrites()));
+}
+
+// Changes the save every frame, never leaving it quiet
+void checkConstantChange(Autosave::TimeType start)
+{
+	hostEEPROM() = HostEEPROM();
+
+	Save save {};
+	Autosave autosave(quietPeriod, maximumDelay);
+	autosave.add(saveAddress, save);
+
+	Autosave::TimeType now = start;
+	Autosave::TimeType dirtySince = start;
+	Autosave::TimeType longestDelay = 0;
+
+	bool dirty = false;
+
+	constexpr size_t frames = 2000;
+
+	for(size_t frame = 0; frame < frames; ++frame, now += frameTime)
+	{
+		++save.level;
+
+		if(!dirty)
+			dirtySince = now;
+
+		autosave.markDirty(0, now);
+		dirty = true;
+
+		if((now - dirtySince) > longestDelay)
+			longestDelay = (now - dirtySince);
+
+		if(autosave.update(now))
+		{
+			check(isSaved(save), "loading a delayed save", start);
+			dirty = false;
+		}
+	}
+
+	check(longestDelay <= (maximumDelay + frameTime), "saving within the maximum delay", start);
+
+	const uint32_t expected = ((frames * frameTime) / maximumDelay);
+	check(autosave.performedWrites() >= expected, "saving often enough", start);
+	check(autosave.performedWrites() <= (expected + 1), "not saving too often", start);
+
+	check(autosave.flush() && isSaved(save), "flushing", start);
+
+	printf("Constant change from %u: %u saves in %zu frames, longest delay %u\n", static_cast<unsigned>(start),
+		static_cast<unsigned>(autosave.performedWrites()), frames, static_cast<unsigned>(longestDelay));
+}
+
+int main()
+{
+	// The second start of each pair wraps around during the run
+	checkBurst(0);
+	checkBurst(0xFFFFFF00u);
+
+	checkConstantChange(0);
+	checkConstantChange(0xFFFFC000u);
+
+	puts(failed ? "Some saves were mistimed or lost" : "Every save was timely and intact");
+
+	return (failed ? 1 : 0);
+}
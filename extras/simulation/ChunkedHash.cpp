@@ -0,0 +1,113 @@
+// ChunkedHash.cpp
+// Checks the records written by writeWithChunkedHash():
+//
+// - Damage to each byte of the object is reported in the bit
+//   of the chunk that holds it, and only in that bit.
+// - Damage to the summary hash code alone is repaired, and reported as 0.
+// - A record that overhangs the end of EEPROM is treated as a unit,
+//   i.e. moved back whole under the clamp policy, and neither written
+//   nor read under the ignore policy.
+#include <Arduboy2EEPROM.h>
+
+#include <stdio.h>
+
+constexpr size_t chunkSize = 4;
+
+struct Save
+{
+	unsigned char bytes[10];
+};
+
+bool failed = false;
+
+void check(bool condition, const char * description, uintptr_t value)
+{
+	if(condition)
+		return;
+
+	printf("%s failed at %u\n", description, static_cast<unsigned>(value));
+	failed = true;
+}
+
+Save makeSave()
+{
+	Save save;
+
+	for(size_t index = 0; index < sizeof(save.bytes); ++index)
+		save.bytes[index] = static_cast<unsigned char>(index * 7);
+
+	return save;
+}
+
+template<typename EEPROM>
+void checkDamageReports()
+{
+	constexpr uintptr_t address = 100;
+	constexpr size_t chunkCount = ((sizeof(Save) + chunkSize - 1) / chunkSize);
+	constexpr uintptr_t summaryAddress = (address + (chunkCount * sizeof(typename EEPROM::HashType)));
+	constexpr uintptr_t objectAddress = (summaryAddress + sizeof(typename EEPROM::HashType));
+
+	const Save save = makeSave();
+
+	for(size_t offset = 0; offset < sizeof(Save); ++offset)
+	{
+		hostEEPROM() = HostEEPROM();
+		EEPROM::template writeWithChunkedHash<chunkSize>(address, save);
+
+		hostEEPROMByte(objectAddress + offset) ^= 0x10;
+
+		Save loaded;
+		const uint32_t damaged = EEPROM::template readWithChunkedHash<chunkSize>(address, loaded);
+
+		check(damaged == (static_cast<uint32_t>(1) << (offset / chunkSize)), "reporting the damaged chunk", offset);
+	}
+
+	for(size_t offset = 0; offset < sizeof(typename EEPROM::HashType); ++offset)
+	{
+		hostEEPROM() = HostEEPROM();
+		EEPROM::template writeWithChunkedHash<chunkSize>(address, save);
+
+		hostEEPROMByte(summaryAddress + offset) ^= 0x01;
+
+		Save loaded;
+		check(EEPROM::template readWithChunkedHash<chunkSize>(address, loaded) == 0, "reporting a damaged summary as intact", offset);
+		check(EEPROM::template verify<Save>(summaryAddress), "repairing the summary", offset);
+	}
+}
+
+template<typename Clamp, typename Ignore>
+void checkRanges(uintptr_t address)
+{
+	const Save save = makeSave();
+	const size_t size = Clamp::chunkedHashSize(sizeof(Save), chunkSize);
+
+	hostEEPROM() = HostEEPROM();
+
+	Save loaded {};
+	Clamp::template writeWithChunkedHash<chunkSize>(address, save);
+	check(Clamp::template readWithChunkedHash<chunkSize>(address, loaded) == 0, "clamped round trip", address);
+
+	if((address + size) <= Ignore::capacity)
+		return;
+
+	hostEEPROM() = HostEEPROM();
+
+	Ignore::template writeWithChunkedHash<chunkSize>(address, save);
+	check(hostEEPROM().programCount == 0, "writing nothing when rejected", address);
+	check(Ignore::template readWithChunkedHash<chunkSize>(address, loaded) == 0x7, "reporting every chunk when rejected", address);
+}
+
+int main()
+{
+	using Clamp = BasicArduboy2EEPROM<Arduboy2EEPROMClampAddressPolicy>;
+	using Ignore = BasicArduboy2EEPROM<Arduboy2EEPROMIgnoreAddressPolicy>;
+
+	checkDamageReports<Arduboy2EEPROM>();
+
+	for(uintptr_t address = 980; address < 1040; ++address)
+		checkRanges<Clamp, Ignore>(address);
+
+	puts(failed ? "Some chunked records were mishandled" : "Every chunked record was handled correctly");
+
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,133 @@
+// CounterPowerLoss.cpp
+// Cuts the power to an Arduboy2EEPROMCounter after every byte
+// programmed by each increment, through several advances of the base
+// value, and checks the guarantees given in the counter's documentation:
+//
+// - The counter remains valid.
+// - It never undercounts, and overcounts by at most incrementsPerBase.
+// - Only an interrupted advance of the base value can overcount.
+// - Once power returns, the next increment adds exactly one.
+//
+// It also checks that erase() programs only the bytes that are not
+// already erased, and that a counter with both slots damaged is
+// reported as invalid.
+#include <Arduboy2EEPROM.h>
+#include <Arduboy2EEPROMCounter.h>
+
+#include <stdio.h>
+
+using EEPROM = Arduboy2EEPROM;
+
+bool failed = false;
+
+void check(bool condition, const char * description, uint32_t value)
+{
+	if(condition)
+		return;
+
+	printf("%s failed at %u\n", description, static_cast<unsigned>(value));
+	failed = true;
+}
+
+template<typename Counter>
+void checkPowerLoss(size_t advances)
+{
+	using ValueType = typename Counter::ValueType;
+
+	hostEEPROM() = HostEEPROM();
+	Counter::reset(10);
+
+	uint32_t cuts = 0;
+	ValueType largestOvercount = 0;
+
+	for(ValueType increment = 0; increment < ((Counter::incrementsPerBase + 1) * advances); ++increment)
+	{
+		const ValueType before = Counter::value();
+		const HostEEPROM saved = hostEEPROM();
+
+		// Measure the bytes programmed by an uninterrupted increment
+		Counter::increment();
+
+		const uint32_t programmed = (hostEEPROM().programCount - saved.programCount);
+		const HostEEPROM completed = hostEEPROM();
+
+		check(Counter::value() == (before + 1), "incrementing", before);
+
+		for(uint32_t cut = 0; cut < programmed; ++cut)
+		{
+			hostEEPROM() = saved;
+			hostEEPROM().programLimit = (saved.programCount + cut);
+
+			Counter::increment();
+
+			hostEEPROM().programLimit = UINT32_MAX;
+			++cuts;
+
+			const ValueType after = Counter::value();
+
+			check(Counter::isValid(), "remaining valid", before);
+			check(after >= before, "not undercounting", before);
+			check(after <= (before + 1 + Counter::incrementsPerBase), "overcounting by at most incrementsPerBase", before);
+
+			// A single bit is cleared unless the base value advances
+			if(programmed == 1)
+				check(after == before, "losing only the interrupted increment", before);
+
+			if((after > (before + 1)) && ((after - before - 1) > largestOvercount))
+				largestOvercount = (after - before - 1);
+
+			Counter::increment();
+			check(Counter::value() == (after + 1), "incrementing after power returns", before);
+		}
+
+		hostEEPROM() = completed;
+	}
+
+	printf("%zu cells: %u power cuts, largest overcount %u of at most %u\n", Counter::cellCount, static_cast<unsigned>(cuts),
+		static_cast<unsigned>(largestOvercount), static_cast<unsigned>(Counter::incrementsPerBase));
+}
+
+void checkErase()
+{
+	hostEEPROM() = HostEEPROM();
+
+	EEPROM::fill(600, 0x12, 4);
+
+	const uint32_t before = hostEEPROM().programCount;
+	EEPROM::erase(598, 8);
+
+	check(hostEEPROM().programCount == (before + 4), "erasing only unerased bytes", hostEEPROM().programCount - before);
+
+	for(uintptr_t address = 598; address < 606; ++address)
+		check(EEPROM::readByte(address) == 0xFF, "erasing", address);
+}
+
+void checkDamagedSlots()
+{
+	using Counter = Arduboy2EEPROMCounter<EEPROM, 500, 2>;
+
+	hostEEPROM() = HostEEPROM();
+	Counter::reset(10);
+
+	constexpr size_t slotSize = ((Counter::storageSize - Counter::cellCount) / 2);
+
+	hostEEPROMByte(Counter::address) ^= 0x01;
+	check(Counter::isValid(), "surviving damage to one slot", 0);
+
+	hostEEPROMByte(Counter::address + slotSize) ^= 0x01;
+	check(!Counter::isValid(), "reporting damage to both slots", 1);
+}
+
+int main()
+{
+	checkPowerLoss<Arduboy2EEPROMCounter<EEPROM, 500, 1>>(4);
+	checkPowerLoss<Arduboy2EEPROMCounter<EEPROM, 500, 2>>(3);
+	checkPowerLoss<Arduboy2EEPROMCounter<EEPROM, 500, 8>>(2);
+
+	checkErase();
+	checkDamagedSlots();
+
+	puts(failed ? "Some power cuts broke the counter's guarantees" : "The counter kept its guarantees through every power cut");
+
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,138 @@
+// RecordRanges.cpp
+// Checks that each function that stores a record with a hash code
+// treats the record (hash codes and object) as a single range,
+// so that the address policy accepts, rejects or adjusts it as a unit.
+//
+// Under the clamp policy, a record written near the end of EEPROM
+// must be found again by reading it from the same address.
+// Under the ignore and flag policies, a record that does not fit
+// must be reported as not intact, and must leave the object untouched,
+// even if the bytes that do lie within EEPROM form a valid hash code.
+// copyWithHash() must refuse to copy between overlapping records,
+// rather than report success and leave a damaged destination.
+#include <Arduboy2EEPROM.h>
+
+#include <stdio.h>
+
+struct Save
+{
+	uint32_t score;
+	uint32_t level;
+};
+
+uint16_t customHash(const Save & save)
+{
+	return static_cast<uint16_t>((save.score * 31u) + save.level);
+}
+
+bool failed = false;
+
+void check(bool condition, const char * description, uintptr_t address)
+{
+	if(condition)
+		return;
+
+	printf("%s failed at address %u\n", description, static_cast<unsigned>(address));
+	failed = true;
+}
+
+template<typename EEPROM>
+void checkClampedRoundTrips(uintptr_t address)
+{
+	const Save save { static_cast<uint32_t>(1000 + address), 7 };
+
+	hostEEPROM() = HostEEPROM();
+
+	Save loaded {};
+	EEPROM::writeWithHash(address, save);
+	check(EEPROM::readWithHash(address, loaded) && (loaded.score == save.score), "writeWithHash then readWithHash", address);
+	check(EEPROM::verify(address, sizeof(Save)), "writeWithHash then verify", address);
+
+	hostEEPROM() = HostEEPROM();
+
+	loaded = Save {};
+	EEPROM::writeWithHash(address, save, customHash);
+	check(EEPROM::readWithHash(address, loaded, customHash) && (loaded.score == save.score), "custom writeWithHash then readWithHash", address);
+}
+
+template<typename EEPROM>
+void checkRejectedRecords(uintptr_t address)
+{
+	hostEEPROM() = HostEEPROM();
+
+	// Whatever part of the record fits within EEPROM is made to look
+	// like an intact record, so that only the range check can reject it
+	const Save save { 1, 2 };
+	EEPROM::writeWithHash(EEPROM::capacity - sizeof(typename EEPROM::HashType) - sizeof(Save), save);
+
+	// An empty sequence of bytes hashes to emptyHash
+	if((address + sizeof(typename EEPROM::HashType)) <= EEPROM::capacity)
+		EEPROM::write(address, EEPROM::emptyHash);
+
+	const Save unread { 0xAAAAAAAA, 0xBBBBBBBB };
+	Save loaded = unread;
+
+	check(!EEPROM::readWithHash(address, loaded), "rejected readWithHash", address);
+	check((loaded.score == unread.score) && (loaded.level == unread.level), "rejected readWithHash leaving the object", address);
+	check(!EEPROM::verify(address, sizeof(Save)), "rejected verify", address);
+	check(!EEPROM::readWithHash(address, loaded, customHash), "rejected custom readWithHash", address);
+}
+
+template<typename EEPROM>
+void checkOverlappingCopies(uintptr_t source)
+{
+	constexpr size_t recordSize = (sizeof(typename EEPROM::HashType) + sizeof(Save));
+
+	for(uintptr_t destination = (source - recordSize); destination <= (source + recordSize); ++destination)
+	{
+		hostEEPROM() = HostEEPROM();
+
+		const Save save { 3, 4 };
+		EEPROM::writeWithHash(source, save);
+
+		const bool overlapping = ((destination + recordSize) > source) && ((source + recordSize) > destination);
+		const bool copied = EEPROM::copyWithHash(destination, source, sizeof(Save));
+
+		check(copied != overlapping, "refusing only overlapping copies", destination);
+
+		if(copied)
+			check(EEPROM::verify(destination, sizeof(Save)), "copying intact", destination);
+	}
+}
+
+int main()
+{
+	using Clamp = BasicArduboy2EEPROM<Arduboy2EEPROMClampAddressPolicy>;
+
+	// Addresses either side of the last that fits every record
+	for(uintptr_t address = 990; address < 1040; ++address)
+		checkClampedRoundTrips<Clamp>(address);
+
+	using Ignore = BasicArduboy2EEPROM<Arduboy2EEPROMIgnoreAddressPolicy>;
+	using Flag = BasicArduboy2EEPROM<Arduboy2EEPROMFlagAddressPolicy>;
+
+	for(uintptr_t address = (Ignore::capacity - sizeof(Ignore::HashType) - sizeof(Save) + 1); address < 1040; ++address)
+	{
+		checkRejectedRecords<Ignore>(address);
+		checkRejectedRecords<Flag>(address);
+	}
+
+	check(Arduboy2EEPROMFlagAddressPolicy::hasError(), "setting the error flag", 0);
+
+	checkOverlappingCopies<Arduboy2EEPROM>(100);
+	checkOverlappingCopies<Ignore>(500);
+
+	// Under the wrap policy, a record at the end overlaps one at the start.
+	// The addresses are not constants, since constant ranges that
+	// wrap are rejected at compile time.
+	volatile uintptr_t wrappedSource = 1020;
+	volatile uintptr_t wrappedDestination = 1030;
+
+	hostEEPROM() = HostEEPROM();
+	Arduboy2EEPROM::writeWithHash(wrappedSource, Save { 5, 6 });
+	check(!Arduboy2EEPROM::copyWithHash(wrappedDestination, wrappedSource, sizeof(Save)), "refusing a wrapped overlapping copy", wrappedDestination);
+
+	puts(failed ? "Some records were not treated as a unit" : "Every record was treated as a unit");
+
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,178 @@
+// ScrubberBitRot.cpp
+// Injects single-bit faults into records watched by an
+// Arduboy2EEPROMScrubber, and measures how many calls to tick()
+// pass before each fault is detected, for several byte budgets.
+//
+// Every bit position is tried at every tick of a pass, so the reported
+// maximum is the true worst case for the configuration, and is checked
+// against the bound given in the documentation of the scrubber:
+// ((totalSize + largestSize - 1) / byteBudget) ticks, rounded up,
+// which is at most two passes of (totalSize / byteBudget) ticks.
+//
+// A second scenario checks that a repair from a backup
+// remains visible once the repaired record is found intact.
+#include <Arduboy2EEPROM.h>
+#include <Arduboy2EEPROMScrubber.h>
+
+#include <stdio.h>
+
+using EEPROM = Arduboy2EEPROM;
+using HashType = EEPROM::HashType;
+using Scrubber = Arduboy2EEPROMScrubber<EEPROM, 4>;
+
+// Deliberately uneven sizes, so that records straddle tick boundaries
+constexpr size_t recordCount = 4;
+constexpr size_t recordSizes[recordCount] = { 16, 7, 33, 4 };
+constexpr uintptr_t recordAddresses[recordCount] = { 0, 64, 128, 256 };
+
+constexpr size_t byteBudgets[] = { 1, 3, 8, 17, 64 };
+
+// Writes every record with a valid hash code
+void writeRecords()
+{
+	hostEEPROM() = HostEEPROM();
+
+	for(size_t record = 0; record < recordCount; ++record)
+	{
+		const uintptr_t objectAddress = (recordAddresses[record] + sizeof(HashType));
+
+		for(size_t index = 0; index < recordSizes[record]; ++index)
+			EEPROM::writeByte(objectAddress + index, static_cast<unsigned char>((record * 31) + index));
+
+		EEPROM::write(recordAddresses[record], EEPROM::hashStored(objectAddress, recordSizes[record]));
+	}
+}
+
+void addRecords(Scrubber & scrubber)
+{
+	for(size_t record = 0; record < recordCount; ++record)
+		scrubber.add(recordAddresses[record], recordSizes[record]);
+}
+
+struct Latency
+{
+	size_t passTicks;
+	size_t bound;
+	size_t maximum;
+	unsigned long total;
+	unsigned long trials;
+	unsigned long missed;
+};
+
+Latency measure(size_t byteBudget)
+{
+	size_t totalSize = 0;
+	size_t largestSize = 0;
+
+	for(size_t record = 0; record < recordCount; ++record)
+	{
+		totalSize += recordSizes[record];
+
+		if(recordSizes[record] > largestSize)
+			largestSize = recordSizes[record];
+	}
+
+	// A fault in a byte that has just been hashed is missed by the
+	// current pass, and found once the record is next finished
+	const size_t worstBytes = (totalSize + largestSize - 1);
+
+	Latency latency { ((totalSize + byteBudget - 1) / byteBudget), ((worstBytes + byteBudget - 1) / byteBudget), 0, 0, 0, 0 };
+
+	// Long enough that a missed fault is not mistaken for a slow one
+	const size_t tickLimit = (4 * latency.passTicks) + 4;
+
+	for(size_t delay = 0; delay < latency.passTicks; ++delay)
+		for(size_t record = 0; record < recordCount; ++record)
+			for(size_t offset = 0; offset < (sizeof(HashType) + recordSizes[record]); ++offset)
+				for(unsigned bit = 0; bit < 8; ++bit)
+				{
+					writeRecords();
+
+					Scrubber scrubber;
+					addRecords(scrubber);
+
+					// Start from a completed pass, then let the fault
+					// land at each point of the following pass
+					while(scrubber.passCount() == 0)
+						scrubber.tick(byteBudget);
+
+					for(size_t tick = 0; tick < delay; ++tick)
+						scrubber.tick(byteBudget);
+
+					hostEEPROMByte(recordAddresses[record] + offset) ^= static_cast<unsigned char>(1u << bit);
+
+					size_t ticks = 0;
+
+					while(scrubber.recordState(record) != Arduboy2EEPROMRecordState::Damaged)
+					{
+						if(ticks == tickLimit)
+							break;
+
+						scrubber.tick(byteBudget);
+						++ticks;
+					}
+
+					++latency.trials;
+
+					if(scrubber.recordState(record) != Arduboy2EEPROMRecordState::Damaged)
+					{
+						++latency.missed;
+						continue;
+					}
+
+					latency.total += ticks;
+
+					if(ticks > latency.maximum)
+						latency.maximum = ticks;
+				}
+
+	return latency;
+}
+
+// A repaired record must stay reported as repaired
+// after later passes find it intact
+bool checkRepairIsSticky()
+{
+	writeRecords();
+
+	// A backup of the first record
+	constexpr uintptr_t backupAddress = 512;
+	EEPROM::copy(backupAddress, recordAddresses[0], sizeof(HashType) + recordSizes[0]);
+
+	Scrubber scrubber;
+	scrubber.add(recordAddresses[0], recordSizes[0], backupAddress);
+
+	hostEEPROMByte(recordAddresses[0] + sizeof(HashType)) ^= 0x01;
+
+	while(scrubber.passCount() < 4)
+		scrubber.tick(5);
+
+	return ((scrubber.recordState(0) == Arduboy2EEPROMRecordState::Repaired) && (scrubber.repairCount() == 1) && EEPROM::verify(recordAddresses[0], recordSizes[0]));
+}
+
+int main()
+{
+	bool success = true;
+
+	// All latencies are in calls to tick()
+	printf("%8s %8s %8s %8s %8s %8s %8s\n", "budget", "pass", "bound", "maximum", "mean", "trials", "missed");
+
+	for(size_t byteBudget : byteBudgets)
+	{
+		const Latency latency = measure(byteBudget);
+
+		printf("%8zu %8zu %8zu %8zu %8.2f %8lu %8lu\n", byteBudget, latency.passTicks, latency.bound, latency.maximum,
+			(static_cast<double>(latency.total) / (latency.trials - latency.missed)), latency.trials, latency.missed);
+
+		if((latency.maximum > latency.bound) || (latency.maximum > (2 * latency.passTicks)) || (latency.missed > 0))
+			success = false;
+	}
+
+	const bool sticky = checkRepairIsSticky();
+	printf("Repair remains visible after later passes: %s\n", (sticky ? "yes" : "no"));
+
+	if(!sticky)
+		success = false;
+
+	return (success ? 0 : 1);
+}
@@ -0,0 +1,157 @@
+// WriteQueue.cpp
+// Drives an Arduboy2EEPROMWriteQueue once per frame and checks that:
+//
+// - An object that changes, and is enqueued again, every frame is still
+//   written within (size / byteBudget) calls to drain(), rounded up,
+//   and the record then holds the object as it was last enqueued.
+// - Higher priorities are written first, unless a lower priority
+//   write is overdue.
+// - A priority beyond the highest is treated as the highest.
+// - The maximum queue depth of each priority is recorded.
+#include <Arduboy2EEPROM.h>
+#include <Arduboy2EEPROMWriteQueue.h>
+
+#include <stdio.h>
+
+using EEPROM = Arduboy2EEPROM;
+using WriteQueue = Arduboy2EEPROMWriteQueue<EEPROM, 4, 2>;
+
+constexpr uint8_t low = 0;
+constexpr uint8_t high = 1;
+
+struct Save
+{
+	unsigned char bytes[40];
+};
+
+constexpr size_t byteBudgets[] = { 1, 3, 4, 7, 16, 64 };
+
+bool failed = false;
+
+void check(bool condition, const char * description, size_t value)
+{
+	if(condition)
+		return;
+
+	printf("%s failed at %zu\n", description, value);
+	failed = true;
+}
+
+bool holds(uintptr_t address, const Save & save)
+{
+	Save loaded {};
+
+	if(!EEPROM::readWithHash(address, loaded))
+		return false;
+
+	for(size_t index = 0; index < sizeof(save.bytes); ++index)
+		if(loaded.bytes[index] != save.bytes[index])
+			return false;
+
+	return true;
+}
+
+void checkConstantChange(size_t byteBudget)
+{
+	hostEEPROM() = HostEEPROM();
+
+	constexpr uintptr_t address = 100;
+
+	Save save {};
+	WriteQueue queue;
+
+	const size_t bound = ((sizeof(Save) + byteBudget - 1) / byteBudget);
+
+	size_t frames = 0;
+	bool completed = false;
+
+	// Long enough that a write that never completes is not mistaken for a slow one
+	while(!completed && (frames < (bound * 4)))
+	{
+		// A different byte changes every frame
+		save.bytes[(frames * 7) % sizeof(save.bytes)] ^= static_cast<unsigned char>(frames + 1);
+
+		queue.enqueue(address, save, high, 1000, frames);
+		completed = queue.drain(frames, byteBudget);
+
+		++frames;
+	}
+
+	check(completed && (frames <= bound), "completing a changing write in time", byteBudget);
+	check(holds(address, save), "holding the last enqueued object", byteBudget);
+
+	printf("%8zu %8zu %8zu\n", byteBudget, bound, frames);
+}
+
+void checkPriorities()
+{
+	hostEEPROM() = HostEEPROM();
+
+	Save settings {};
+	Save progress {};
+	WriteQueue queue;
+
+	queue.enqueue(100, settings, low, 1000, 0);
+	queue.enqueue(200, progress, high, 1000, 0);
+
+	queue.drain(1, sizeof(Save));
+	check(holds(200, progress) && !holds(100, settings), "writing the higher priority first", 0);
+
+	queue.drain(2, sizeof(Save));
+	check(holds(100, settings), "writing the lower priority next", 0);
+
+	hostEEPROM() = HostEEPROM();
+
+	queue.enqueue(300, settings, low, 10, 0);
+	queue.enqueue(400, progress, high, 1000, 0);
+
+	queue.drain(11, sizeof(Save));
+	check(holds(300, settings) && !holds(400, progress), "writing an overdue lower priority first", 0);
+
+	queue.drain(12, sizeof(Save));
+
+	queue.enqueue(500, settings, 200, 1000, 20);
+	queue.drain(21, sizeof(Save));
+	check(queue.durableCount(high) == 3, "treating an excessive priority as the highest", 200);
+}
+
+void checkDepths()
+{
+	hostEEPROM() = HostEEPROM();
+
+	Save saves[4] {};
+	WriteQueue queue;
+
+	for(size_t index = 0; index < 3; ++index)
+		queue.enqueue(100 + (index * 50), saves[index], low, 1000, 0);
+
+	queue.enqueue(300, saves[3], high, 1000, 0);
+
+	check(queue.maximumQueueDepth(low) == 3, "recording the low priority depth", 3);
+	check(queue.maximumQueueDepth(high) == 1, "recording the high priority depth", 1);
+
+	// Raising the priority of a pending write
+	queue.enqueue(100, saves[0], high, 1000, 1);
+	check(queue.maximumQueueDepth(high) == 2, "recording a raised priority", 2);
+
+	while(queue.queueDepth() > 0)
+		queue.drain(2, sizeof(Save));
+
+	check(queue.maximumQueueDepth(low) == 3, "keeping the maximum once drained", 3);
+}
+
+int main()
+{
+	// All times are in calls to drain()
+	printf("%8s %8s %8s\n", "budget", "bound", "frames");
+
+	for(size_t byteBudget : byteBudgets)
+		checkConstantChange(byteBudget);
+
+	checkPriorities();
+	checkDepths();
+
+	puts(failed ? "Some writes were late, lost or misordered" : "Every write was timely, intact and in order");
+
+	return (failed ? 1 : 0);
+}
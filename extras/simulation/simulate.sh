@@ -0,0 +1,48 @@
+#!/bin/sh
+#
+# Builds and runs each simulation in this directory on the host,
+# using the stand-in avr-libc headers in extras/host, and fails
+# if any simulation reports that the behaviour it measures
+# does not match the documentation.
+#
+# Usage:
+#   simulate.sh
+#
+# Environment:
+#   HOST_CXX  The compiler to use (default: c++)
+#
+# Each simulation is a program that prints its measurements
+# and exits with a non-zero status upon a mismatch.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+source="$here/../../src"
+build="$here/build"
+
+CXX=${HOST_CXX:-c++}
+
+rm -rf "$build"
+mkdir -p "$build"
+
+status=0
+
+for simulation in "$here"/*.cpp
+do
+	name=$(basename "$simulation" .cpp)
+	program="$build/$name"
+
+	"$CXX" -I"$here/../host" -I"$source" -std=gnu++11 -O2 -Wall -Wextra "$simulation" -o "$program"
+
+	echo "== $name"
+
+	if ! "$program"
+	then
+		echo "$name: failed"
+		status=1
+	fi
+
+	echo
+done
+
+exit "$status"
@@ -0,0 +1,227 @@
+#pragma once
+
+/// @file Arduboy2EEPROMAddressPolicies.h
+/// @brief Policies for handling invalid EEPROM addresses.
+/// @details
+/// An address policy decides what happens when `BasicArduboy2EEPROM`
+/// is asked to access an address outside of EEPROM.
+/// Policies are selected at compile time, thus a policy that performs
+/// no checks costs nothing at run time.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t
+#include <stdint.h>
+
+// For abort
+#include <stdlib.h>
+
+/// @brief
+/// Functionality shared by the address policies.
+///
+/// @details
+/// Every address policy provides four `static` functions,
+/// of which `isValidRange`, `mapAddress` and `supportsCapacity`
+/// are provided by this base unless a policy overrides them:
+///
+/// @li `bool checkRange(uintptr_t & address, size_t size, size_t capacity)` &mdash;
+/// Called once per operation, before any bytes are accessed.
+/// Returns `true` if the operation should proceed, and may adjust `address`.
+/// @li `uintptr_t mapAddress(uintptr_t address, size_t capacity)` &mdash;
+/// Called for each byte of an operation that was allowed to proceed,
+/// and returns the address that is to be accessed.
+/// @li `constexpr bool supportsCapacity(size_t capacity)` &mdash;
+/// Determines at compile time whether the policy can be used
+/// with an EEPROM of the given capacity.
+/// @li `constexpr bool isValidRange(uintptr_t address, size_t size, size_t capacity)` &mdash;
+/// Determines whether a range lies entirely within EEPROM.
+/// Used to report constant invalid ranges at compile time,
+/// regardless of how `checkRange` handles them at run time.
+struct Arduboy2EEPROMAddressPolicyBase
+{
+	/// @brief
+	/// Accepts any capacity.
+	static constexpr bool supportsCapacity(size_t)
+	{
+		return true;
+	}
+
+	/// @brief
+	/// Determines whether a range of bytes lies entirely within EEPROM.
+	///
+	/// @param[in] address
+	/// The address of the first byte in the range.
+	///
+	/// @param[in] size
+	/// The number of bytes in the range.
+	///
+	/// @param[in] capacity
+	/// The number of bytes of EEPROM.
+	///
+	/// @retval true The range lies entirely within EEPROM.
+	/// @retval false Some or all of the range lies outside of EEPROM.
+	static constexpr bool isValidRange(uintptr_t address, size_t size, size_t capacity)
+	{
+		// Written so as to avoid overflow when address or size are large
+		return ((address <= capacity) && (size <= (capacity - address)));
+	}
+
+	/// @brief
+	/// Returns `address` unchanged.
+	static constexpr uintptr_t mapAddress(uintptr_t address, size_t)
+	{
+		return address;
+	}
+};
+
+/// @brief
+/// Makes addresses wrap around by discarding the bits above
+/// the most significant bit of the last valid address.
+///
+/// @pre
+/// @li The capacity of EEPROM **must** be a power of two.
+///
+/// @note
+/// This policy performs no branching,
+/// and mirrors what the AVR hardware does implicitly.
+struct Arduboy2EEPROMWrapAddressPolicy : Arduboy2EEPROMAddressPolicyBase
+{
+	/// @brief
+	/// Accepts only capacities that are powers of two.
+	static constexpr bool supportsCapacity(size_t capacity)
+	{
+		return ((capacity & (capacity - 1)) == 0);
+	}
+
+	/// @brief
+	/// Allows every operation to proceed.
+	static constexpr bool checkRange(uintptr_t &, size_t, size_t)
+	{
+		return true;
+	}
+
+	/// @brief
+	/// Wraps `address` into the range of valid addresses.
+	static constexpr uintptr_t mapAddress(uintptr_t address, size_t capacity)
+	{
+		return (address & (capacity - 1));
+	}
+};
+
+/// @brief
+/// Moves a range that extends beyond the end of EEPROM back
+/// such that its last byte is the last byte of EEPROM.
+///
+/// @note
+/// Operations on ranges larger than EEPROM itself are ignored.
+struct Arduboy2EEPROMClampAddressPolicy : Arduboy2EEPROMAddressPolicyBase
+{
+	/// @brief
+	/// Clamps `address` such that the range fits within EEPROM.
+	static bool checkRange(uintptr_t & address, size_t size, size_t capacity)
+	{
+		if(size > capacity)
+			return false;
+
+		if(address > (capacity - size))
+			address = (capacity - size);
+
+		return true;
+	}
+};
+
+/// @brief
+/// Ignores any operation on a range that does not lie
+/// entirely within EEPROM.
+///
+/// @note
+/// Ignored write operations write nothing.
+/// Ignored read operations leave their destination untouched,
+/// except `readByte`, which returns `0xFF`, the value of erased EEPROM.
+struct Arduboy2EEPROMIgnoreAddressPolicy : Arduboy2EEPROMAddressPolicyBase
+{
+	/// @brief
+	/// Allows an operation to proceed only if its range is valid.
+	static constexpr bool checkRange(uintptr_t & address, size_t size, size_t capacity)
+	{
+		return isValidRange(address, size, capacity);
+	}
+};
+
+/// @brief
+/// Ignores any operation on a range that does not lie
+/// entirely within EEPROM, and sets an error flag.
+///
+/// @details
+/// The flag remains set until `clearError()` is called.
+///
+/// @see Arduboy2EEPROMIgnoreAddressPolicy
+struct Arduboy2EEPROMFlagAddressPolicy : Arduboy2EEPROMAddressPolicyBase
+{
+	/// @brief
+	/// Determines whether an invalid address has been used
+	/// since the flag was last cleared.
+	static bool hasError()
+	{
+		return errorFlag();
+	}
+
+	/// @brief
+	/// Clears the error flag.
+	static void clearError()
+	{
+		errorFlag() = false;
+	}
+
+	/// @brief
+	/// Allows an operation to proceed only if its range is valid,
+	/// setting the error flag otherwise.
+	static bool checkRange(uintptr_t & address, size_t size, size_t capacity)
+	{
+		if(isValidRange(address, size, capacity))
+			return true;
+
+		errorFlag() = true;
+		return false;
+	}
+
+private:
+	static bool & errorFlag()
+	{
+		static bool flag = false;
+		return flag;
+	}
+};
+
+/// @brief
+/// Calls `abort()` upon any operation on a range that does not
+/// lie entirely within EEPROM.
+struct Arduboy2EEPROMAbortAddressPolicy : Arduboy2EEPROMAddressPolicyBase
+{
+	/// @brief
+	/// Aborts the program if the range is invalid.
+	static bool checkRange(uintptr_t & address, size_t size, size_t capacity)
+	{
+		if(!isValidRange(address, size, capacity))
+			abort();
+
+		return true;
+	}
+};
+
+/// @brief
+/// The address policy used by `Arduboy2EEPROM`.
+///
+/// @details
+/// If `ARDUBOY2EEPROM_CHECK_ADDRESSES` is defined before this file
+/// is included, this is `Arduboy2EEPROMAbortAddressPolicy`,
+/// which is useful whilst debugging.
+/// Otherwise it is `Arduboy2EEPROMWrapAddressPolicy`,
+/// which costs no more than the AVR's own implicit wrapping.
+#if defined(ARDUBOY2EEPROM_CHECK_ADDRESSES)
+using Arduboy2EEPROMDefaultAddressPolicy = Arduboy2EEPROMAbortAddressPolicy;
+#else
+using Arduboy2EEPROMDefaultAddressPolicy = Arduboy2EEPROMWrapAddressPolicy;
+#endif
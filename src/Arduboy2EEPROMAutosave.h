@@ -0,0 +1,273 @@
+#pragma once
+
+/// @file Arduboy2EEPROMAutosave.h
+/// @brief The `Arduboy2EEPROMAutosave` class template.
+/// @details Coalesces frequent save requests into fewer writes.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t, uint32_t
+#include <stdint.h>
+
+/// @brief
+/// Delays saving records until they have stopped changing,
+/// so that a record modified many times in quick succession
+/// (e.g. at every checkpoint) is written to EEPROM only once.
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @tparam maximumRecords
+/// The maximum number of records that can be registered.
+///
+/// @details
+/// Each record is an object in RAM, registered with `add()` along with
+/// the address at which it is to be saved. Whenever the object changes,
+/// the program calls `markDirty()` instead of `writeWithHash()`,
+/// and regularly calls `update()`, e.g. once per frame.
+/// `update()` saves each dirty record once it has been left unchanged
+/// for the _quiet period_, or once it has been dirty for the
+/// _maximum delay_, whichever comes first, so that a record that
+/// never stops changing is still saved eventually.
+/// `flush()` saves every dirty record immediately,
+/// e.g. when the player chooses to quit.
+///
+/// Records are saved with `writeWithHash()`,
+/// and can be loaded with `readWithHash()`.
+///
+/// Times are given by the program, in any unit, e.g. by `millis()`.
+/// Only differences between times are used, thus times may wrap around.
+///
+/// @warning
+/// Each registered object **must** remain alive,
+/// and at the same location, for as long as the autosave does.
+template<typename EEPROM, size_t maximumRecords = 4>
+class Arduboy2EEPROMAutosave
+{
+public:
+	/// @brief
+	/// The type used for times.
+	using TimeType = uint32_t;
+
+	/// @brief
+	/// The maximum number of records that can be registered.
+	static constexpr size_t recordCapacity = maximumRecords;
+
+	static_assert(maximumRecords > 0, "The autosave must be able to hold at least one record");
+
+private:
+	// Saves an object of a particular type with writeWithHash
+	using SaveFunction = void (*)(uintptr_t address, const unsigned char * data);
+
+	struct Record
+	{
+		const unsigned char * data;
+		uintptr_t address;
+		SaveFunction saveFunction;
+
+		// When the record first became dirty, and when it last changed
+		TimeType firstChange;
+		TimeType lastChange;
+
+		bool dirty;
+	};
+
+	Record records[maximumRecords];
+	size_t count = 0;
+
+	TimeType quietDuration;
+	TimeType delayLimit;
+
+	uint32_t absorbed = 0;
+	uint32_t performed = 0;
+
+	template<typename Type>
+	static void saveObject(uintptr_t address, const unsigned char * data)
+	{
+		EEPROM::writeWithHash(address, *reinterpret_cast<const Type *>(data));
+	}
+
+	void save(Record & record)
+	{
+		record.saveFunction(record.address, record.data);
+
+		record.dirty = false;
+		++performed;
+	}
+
+public:
+	/// @brief
+	/// Constructs an autosave with no records.
+	///
+	/// @param[in] quietPeriod
+	/// How long a record must be left unchanged before it is saved.
+	///
+	/// @param[in] maximumDelay
+	/// The longest a record may remain dirty before it is saved,
+	/// even if it is still changing.
+	Arduboy2EEPROMAutosave(TimeType quietPeriod, TimeType maximumDelay) :
+		quietDuration(quietPeriod), delayLimit(maximumDelay)
+	{
+	}
+
+	/// @brief
+	/// Registers an object to be saved.
+	///
+	/// @param[in] address
+	/// The address at which the object and its hash code are to be saved.
+	///
+	/// @param[in] object
+	/// The object to be saved, which must outlive the autosave.
+	///
+	/// @retval true The object was registered. Its index is the
+	/// number of objects registered before it.
+	/// @retval false The autosave is full.
+	template<typename Type>
+	bool add(uintptr_t address, const Type & object)
+	{
+		if(count >= maximumRecords)
+			return false;
+
+		records[count] = Record { reinterpret_cast<const unsigned char *>(&object), address, &saveObject<Type>, 0, 0, false };
+		++count;
+
+		return true;
+	}
+
+	/// @brief
+	/// Temporary objects cannot be registered, since they would
+	/// be destroyed long before they could be saved.
+	template<typename Type>
+	bool add(uintptr_t address, const Type && object) = delete;
+
+	/// @brief
+	/// Records that an object has changed and will need to be saved.
+	///
+	/// @par Complexity
+	/// `O(1)`.
+	///
+	/// @param[in] index
+	/// The index of the object, in the order in which objects were added.
+	///
+	/// @param[in] now
+	/// The current time.
+	///
+	/// @pre
+	/// @li `(index < recordCount())`
+	void markDirty(size_t index, TimeType now)
+	{
+		Record & record = records[index];
+
+		if(record.dirty)
+		{
+			// The write this would have caused is absorbed
+			// by the one still pending
+			++absorbed;
+		}
+		else
+		{
+			record.dirty = true;
+			record.firstChange = now;
+		}
+
+		record.lastChange = now;
+	}
+
+	/// @brief
+	/// Saves each dirty object that is due to be saved.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `recordCount()`,
+	/// plus the cost of any saves.
+	///
+	/// @param[in] now
+	/// The current time.
+	///
+	/// @retval true At least one object was saved.
+	/// If the EEPROM implementation requires it,
+	/// `commit()` should then be called.
+	/// @retval false Nothing was saved.
+	bool update(TimeType now)
+	{
+		bool saved = false;
+
+		for(size_t index = 0; index < count; ++index)
+		{
+			Record & record = records[index];
+
+			if(!record.dirty)
+				continue;
+
+			if(((now - record.lastChange) >= quietDuration) || ((now - record.firstChange) >= delayLimit))
+			{
+				save(record);
+				saved = true;
+			}
+		}
+
+		return saved;
+	}
+
+	/// @brief
+	/// Saves every dirty object immediately.
+	///
+	/// @retval true At least one object was saved.
+	/// If the EEPROM implementation requires it,
+	/// `commit()` should then be called.
+	/// @retval false Nothing was saved.
+	bool flush()
+	{
+		bool saved = false;
+
+		for(size_t index = 0; index < count; ++index)
+		{
+			if(records[index].dirty)
+			{
+				save(records[index]);
+				saved = true;
+			}
+		}
+
+		return saved;
+	}
+
+	/// @brief
+	/// Determines whether any object is waiting to be saved.
+	bool isDirty() const
+	{
+		for(size_t index = 0; index < count; ++index)
+			if(records[index].dirty)
+				return true;
+
+		return false;
+	}
+
+	/// @brief
+	/// Returns the number of registered objects.
+	size_t recordCount() const
+	{
+		return count;
+	}
+
+	/// @brief
+	/// Returns the number of writes that were avoided, i.e. the number
+	/// of calls to `markDirty()` for objects that were already dirty.
+	uint32_t absorbedWrites() const
+	{
+		return absorbed;
+	}
+
+	/// @brief
+	/// Returns the number of times an object has been saved.
+	uint32_t performedWrites() const
+	{
+		return performed;
+	}
+};
+
+// Definitions of the static member constants,
+// required prior to C++17 if they are odr-used
+template<typename EEPROM, size_t maximumRecords>
+constexpr size_t Arduboy2EEPROMAutosave<EEPROM, maximumRecords>::recordCapacity;
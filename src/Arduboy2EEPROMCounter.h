@@ -0,0 +1,257 @@
+#pragma once
+
+/// @file Arduboy2EEPROMCounter.h
+/// @brief The `Arduboy2EEPROMCounter` class template.
+/// @details A counter that spreads the wear of frequent increments across several bytes.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t, uint32_t
+#include <stdint.h>
+
+/// @brief
+/// A counter stored in EEPROM that is incremented by clearing bits,
+/// so that frequent increments (e.g. a play count or a death count)
+/// do not repeatedly erase and reprogram the same byte.
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @tparam counterAddress
+/// The address of the counter.
+///
+/// @tparam counterCellCount
+/// The number of bytes in which increments are recorded.
+///
+/// @details
+/// The counter consists of two _slots_, each holding a base value and
+/// a sequence number, stored with a hash code as if by `writeWithHash()`,
+/// followed by `cellCount` bytes (the _cells_).
+/// The value of the counter is the base value of the newest intact slot
+/// (i.e. the intact slot with the higher sequence number)
+/// plus the number of bits that have been cleared in the cells.
+///
+/// Each increment clears a single bit with `EEPROM::clearBits()`,
+/// filling the cells in order, and only once every bit has been cleared
+/// is the base value advanced and the cells erased with `EEPROM::erase()`.
+/// The advanced base value is written to the older slot,
+/// so the newest slot remains intact until the write is complete.
+/// Each cell is therefore erased only once per `(8 * cellCount)`
+/// increments, and each slot is rewritten half as often.
+///
+/// All functions are `static`, as the counter keeps no state outside of EEPROM.
+///
+/// @note
+/// The counter never decreases, except through `reset()`.
+/// If an increment that advances the base value is interrupted
+/// (e.g. by a loss of power) whilst the slot is being written,
+/// the increment is lost, but the counter keeps its previous value.
+/// If it is interrupted whilst the cells are being erased,
+/// the counter may overcount by up to `(8 * cellCount)`.
+/// Either way, the counter will not undercount,
+/// unless the newest slot is later damaged.
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount = 8>
+class Arduboy2EEPROMCounter
+{
+public:
+	/// @brief
+	/// The type of the counter's value.
+	using ValueType = uint32_t;
+
+	/// @brief
+	/// The address of the counter.
+	static constexpr uintptr_t address = counterAddress;
+
+	/// @brief
+	/// The number of bytes in which increments are recorded.
+	static constexpr size_t cellCount = counterCellCount;
+
+	/// @brief
+	/// The number of increments recorded between advances of the base value.
+	static constexpr ValueType incrementsPerBase = (cellCount * 8);
+
+private:
+	struct Slot
+	{
+		ValueType base;
+		uint32_t sequence;
+	};
+
+	static constexpr size_t slotSize = (sizeof(typename EEPROM::HashType) + sizeof(Slot));
+
+public:
+	/// @brief
+	/// The number of bytes of EEPROM occupied by the counter.
+	static constexpr size_t storageSize = ((2 * slotSize) + cellCount);
+
+	static_assert(cellCount > 0, "A counter must have at least one cell");
+	static_assert((counterAddress + storageSize) <= EEPROM::capacity, "The counter must lie within EEPROM");
+
+private:
+	static constexpr uintptr_t cellsAddress = (counterAddress + (2 * slotSize));
+
+	static constexpr uintptr_t slotAddress(size_t slot)
+	{
+		return (counterAddress + (slot * slotSize));
+	}
+
+	// Returns the index of the newest intact slot, which is read into
+	// newest, or 2 if neither slot is intact, in which case newest is zero
+	static size_t readNewestSlot(Slot & newest)
+	{
+		size_t newestIndex = 2;
+		newest = Slot { 0, 0 };
+
+		for(size_t slot = 0; slot < 2; ++slot)
+		{
+			Slot candidate;
+
+			if(!EEPROM::readWithHash(slotAddress(slot), candidate))
+				continue;
+
+			if((newestIndex == 2) || (candidate.sequence > newest.sequence))
+			{
+				newestIndex = slot;
+				newest = candidate;
+			}
+		}
+
+		return newestIndex;
+	}
+
+	static ValueType countClearedBits(unsigned char byte)
+	{
+		ValueType count = 0;
+
+		for(unsigned char bits = static_cast<unsigned char>(~byte); bits != 0; bits &= (bits - 1))
+			++count;
+
+		return count;
+	}
+
+public:
+	/// @brief
+	/// Sets the counter to a specified value, erasing the cells.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `cellCount`.
+	///
+	/// @param[in] value
+	/// The new value of the counter.
+	///
+	/// @pre
+	/// @li `EEPROM::begin()` has been called previously in the program.
+	///
+	/// @note
+	/// A counter **must** be reset once before its first use,
+	/// so that it has a valid base value.
+	///
+	/// @details
+	/// Both slots are written, and the second becomes the newest,
+	/// thus if this is interrupted before the second slot is complete,
+	/// the counter keeps its previous value.
+	static void reset(ValueType value = 0)
+	{
+		EEPROM::writeWithHash(slotAddress(0), Slot { value, 0 });
+		EEPROM::writeWithHash(slotAddress(1), Slot { value, 1 });
+		EEPROM::erase(cellsAddress, cellCount);
+	}
+
+	/// @brief
+	/// Determines whether the counter has an intact base value.
+	///
+	/// @retval true At least one slot matched its hash code.
+	/// @retval false Both slots were damaged, or the counter
+	/// has never been reset.
+	static bool isValid()
+	{
+		Slot newest;
+		return (readNewestSlot(newest) < 2);
+	}
+
+	/// @brief
+	/// Returns the value of the counter.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `cellCount`.
+	///
+	/// @pre
+	/// @li `EEPROM::begin()` has been called previously in the program.
+	/// @li `isValid()` &mdash; Otherwise the base value is taken to be `0`.
+	static ValueType value()
+	{
+		Slot newest;
+		readNewestSlot(newest);
+
+		ValueType value = newest.base;
+
+		for(size_t cell = 0; cell < cellCount; ++cell)
+			value += countClearedBits(EEPROM::readByte(cellsAddress + cell));
+
+		return value;
+	}
+
+	/// @brief
+	/// Adds one to the counter.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `cellCount`.
+	///
+	/// @pre
+	/// @li `EEPROM::begin()` has been called previously in the program.
+	///
+	/// @details
+	/// Usually clears a single bit of a single cell.
+	/// Once every bit has been cleared, the base value is advanced
+	/// by `incrementsPerBase` and written to the older slot,
+	/// and the cells are erased instead.
+	static void increment()
+	{
+		for(size_t cell = 0; cell < cellCount; ++cell)
+		{
+			const unsigned char byte = EEPROM::readByte(cellsAddress + cell);
+
+			if(byte == 0)
+				continue;
+
+			// Clear the lowest set bit
+			EEPROM::clearBits(cellsAddress + cell, static_cast<unsigned char>(byte & (byte - 1)));
+			return;
+		}
+
+		Slot newest;
+		const size_t newestIndex = readNewestSlot(newest);
+
+		// The older slot is overwritten, so that if this is interrupted,
+		// the newest slot still holds the previous base value.
+		// If neither slot is intact, the first is written.
+		const size_t older = ((newestIndex == 0) ? 1 : 0);
+
+		// The new base value is written before the cells are erased,
+		// so that an interruption can only cause an overcount
+		EEPROM::writeWithHash(slotAddress(older), Slot { static_cast<ValueType>(newest.base + incrementsPerBase + 1), (newest.sequence + 1) });
+		EEPROM::erase(cellsAddress, cellCount);
+	}
+};
+
+// Definitions of the static member constants,
+// required prior to C++17 if they are odr-used
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount>
+constexpr uintptr_t Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::address;
+
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount>
+constexpr size_t Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::cellCount;
+
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount>
+constexpr typename Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::ValueType Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::incrementsPerBase;
+
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount>
+constexpr size_t Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::storageSize;
+
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount>
+constexpr size_t Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::slotSize;
+
+template<typename EEPROM, uintptr_t counterAddress, size_t counterCellCount>
+constexpr uintptr_t Arduboy2EEPROMCounter<EEPROM, counterAddress, counterCellCount>::cellsAddress;
@@ -0,0 +1,368 @@
+#pragma once
+
+/// @file Arduboy2EEPROMHashIndex.h
+/// @brief The `Arduboy2EEPROMHashIndex` class template.
+/// @details A tree of hash codes over fixed-size blocks of EEPROM.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t
+#include <stdint.h>
+
+// For Arduboy2EEPROMTrackedWrites
+#include "Arduboy2EEPROMTrackedWrites.h"
+
+/// @brief
+/// A tree of hash codes (also known as a _Merkle tree_) over a region of
+/// EEPROM that has been divided into fixed-size blocks.
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @tparam indexBlockSize
+/// The number of bytes in each block.
+///
+/// @tparam indexAddress
+/// The address of the first byte of the indexed region.
+///
+/// @tparam indexSize
+/// The number of bytes in the indexed region.
+/// Must be a multiple of `indexBlockSize`, and the resulting number
+/// of blocks must be a power of two.
+/// The default indexes the whole of EEPROM, which leaves no room to
+/// store the tree in EEPROM with `writeTo()`. To do so, index a smaller
+/// region, and store the tree in the bytes outside of it.
+///
+/// @details
+/// Each leaf of the tree is the hash code of one block,
+/// and every other node is the hash code of its two children,
+/// thus the root hash changes whenever any block changes.
+///
+/// Once the tree has been built with `rebuild()`,
+/// write operations made through the index (e.g. `write()`, inherited
+/// from `Arduboy2EEPROMTrackedWrites`) record the blocks they modify,
+/// as does `markModified()`,
+/// and `update()` (typically called alongside `commit()`)
+/// rehashes only those blocks and their ancestors.
+/// Two trees can be compared with `compare()`, which only descends
+/// into subtrees whose hash codes differ, thus finding the changed
+/// blocks in time proportional to the number of changed blocks.
+///
+/// The tree may be kept in RAM, persisted by the host,
+/// or stored in a reserved region of EEPROM outside of
+/// the indexed region with `writeTo()` and `readFrom()`.
+///
+/// @warning
+/// The index can only observe writes made through it.
+/// Every other write to the indexed region **must** be reported
+/// via `markModified()` before the next call to `update()`.
+template<typename EEPROM, size_t indexBlockSize = 64, uintptr_t indexAddress = 0, size_t indexSize = EEPROM::capacity>
+class Arduboy2EEPROMHashIndex : public Arduboy2EEPROMTrackedWrites<Arduboy2EEPROMHashIndex<EEPROM, indexBlockSize, indexAddress, indexSize>, EEPROM>
+{
+public:
+	/// @brief
+	/// The type of the hash codes stored in the tree.
+	using HashType = typename EEPROM::HashType;
+
+	/// @brief
+	/// The number of bytes in each block.
+	static constexpr size_t blockSize = indexBlockSize;
+
+	/// @brief
+	/// The number of blocks in the indexed region.
+	static constexpr size_t blockCount = (indexSize / indexBlockSize);
+
+	/// @brief
+	/// The number of bytes needed to store the tree with `writeTo()`.
+	static constexpr size_t storageSize = (sizeof(HashType) * ((blockCount * 2) - 1));
+
+	static_assert(indexBlockSize > 0, "Block size must not be zero");
+	static_assert((indexSize % indexBlockSize) == 0, "The indexed region must be a whole number of blocks");
+	static_assert((blockCount & (blockCount - 1)) == 0, "The number of blocks must be a power of two");
+	static_assert((indexAddress + indexSize) <= EEPROM::capacity, "The indexed region must lie within EEPROM");
+
+private:
+	// The nodes of the tree, in breadth-first order:
+	// nodes[1] is the root, the children of nodes[n] are
+	// nodes[2n] and nodes[2n + 1], and the leaves begin at nodes[blockCount].
+	// nodes[0] is unused.
+	HashType nodes[blockCount * 2];
+
+	// One bit per block, set for blocks modified since the last update
+	unsigned char modified[(blockCount + 7) / 8];
+
+	friend class Arduboy2EEPROMTrackedWrites<Arduboy2EEPROMHashIndex, EEPROM>;
+
+	// Called after each write made through the index
+	void onWritten(uintptr_t address, size_t size)
+	{
+		markModified(address, size);
+	}
+
+	static constexpr uintptr_t blockAddress(size_t block)
+	{
+		return (indexAddress + (block * blockSize));
+	}
+
+	void hashChildren(size_t node)
+	{
+		// The two children are adjacent, and are hashed as one sequence
+		nodes[node] = EEPROM::hash(reinterpret_cast<const unsigned char *>(&nodes[node * 2]), (sizeof(HashType) * 2));
+	}
+
+	bool isModified(size_t block) const
+	{
+		return ((modified[block / 8] & (1u << (block % 8))) != 0);
+	}
+
+	template<typename Visitor>
+	void compareNode(const Arduboy2EEPROMHashIndex & other, size_t node, Visitor & visitor) const
+	{
+		if(nodes[node] == other.nodes[node])
+			return;
+
+		if(node >= blockCount)
+		{
+			visitor(node - blockCount);
+			return;
+		}
+
+		compareNode(other, (node * 2), visitor);
+		compareNode(other, ((node * 2) + 1), visitor);
+	}
+
+public:
+	/// @brief
+	/// Rehashes every block and rebuilds the whole tree.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `indexSize`.
+	///
+	/// @pre
+	/// @li `EEPROM::begin()` has been called previously in the program.
+	void rebuild()
+	{
+		for(size_t block = 0; block < blockCount; ++block)
+			nodes[blockCount + block] = EEPROM::hashStored(blockAddress(block), blockSize);
+
+		for(size_t node = (blockCount - 1); node > 0; --node)
+			hashChildren(node);
+
+		for(size_t index = 0; index < sizeof(modified); ++index)
+			modified[index] = 0;
+	}
+
+	/// @brief
+	/// Records that a range of bytes has been written to.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is the number of blocks the range overlaps.
+	///
+	/// @param[in] address
+	/// The address of the first byte that was written.
+	///
+	/// @param[in] size
+	/// The number of contiguous bytes that were written.
+	///
+	/// @note
+	/// Any part of the range that lies outside
+	/// of the indexed region is ignored.
+	/// However, a range that does not lie entirely within EEPROM
+	/// marks every block as modified, since the address policy
+	/// may have redirected the write anywhere (e.g. by wrapping it).
+	void markModified(uintptr_t address, size_t size)
+	{
+		if(size == 0)
+			return;
+
+		if((address > EEPROM::capacity) || (size > (EEPROM::capacity - address)))
+		{
+			for(size_t index = 0; index < sizeof(modified); ++index)
+				modified[index] = 0xFF;
+
+			return;
+		}
+
+		const uintptr_t begin = ((address > indexAddress) ? address : indexAddress);
+		const uintptr_t end = (((address + size) < (indexAddress + indexSize)) ? (address + size) : (indexAddress + indexSize));
+
+		if(begin >= end)
+			return;
+
+		const size_t firstBlock = ((begin - indexAddress) / blockSize);
+		const size_t lastBlock = ((end - 1 - indexAddress) / blockSize);
+
+		for(size_t block = firstBlock; block <= lastBlock; ++block)
+			modified[block / 8] |= (1u << (block % 8));
+	}
+
+	/// @brief
+	/// Rehashes the blocks recorded by `markModified()`
+	/// and updates the tree accordingly.
+	///
+	/// @par Complexity
+	/// `O(m * (b + log n))`, where `m` is the number of modified blocks,
+	/// `b` is `blockSize`, and `n` is `blockCount`.
+	///
+	/// @return
+	/// The number of blocks that were rehashed.
+	///
+	/// @pre
+	/// @li `rebuild()` has been called previously.
+	size_t update()
+	{
+		size_t count = 0;
+
+		for(size_t block = 0; block < blockCount; ++block)
+		{
+			if(!isModified(block))
+				continue;
+
+			size_t node = (blockCount + block);
+
+			nodes[node] = EEPROM::hashStored(blockAddress(block), blockSize);
+
+			// Ancestors shared with other modified blocks
+			// are rehashed more than once, which is cheap
+			// compared to rehashing a block
+			for(node /= 2; node > 0; node /= 2)
+				hashChildren(node);
+
+			++count;
+		}
+
+		for(size_t index = 0; index < sizeof(modified); ++index)
+			modified[index] = 0;
+
+		return count;
+	}
+
+	/// @brief
+	/// Returns the hash code at the root of the tree,
+	/// which summarises the entire indexed region.
+	HashType rootHash() const
+	{
+		return nodes[1];
+	}
+
+	/// @brief
+	/// Returns the hash code of the specified block.
+	///
+	/// @pre
+	/// @li `(block < blockCount)`
+	HashType blockHash(size_t block) const
+	{
+		return nodes[blockCount + block];
+	}
+
+	/// @brief
+	/// Determines whether the contents of a block in EEPROM
+	/// still match the hash code recorded in the tree.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `blockSize`.
+	///
+	/// @pre
+	/// @li `(block < blockCount)`
+	bool verifyBlock(size_t block) const
+	{
+		return (EEPROM::hashStored(blockAddress(block), blockSize) == blockHash(block));
+	}
+
+	/// @brief
+	/// Finds the blocks whose hash codes differ between two trees.
+	///
+	/// @par Complexity
+	/// `O(m * log n)`, where `m` is the number of differing blocks
+	/// and `n` is `blockCount`.
+	///
+	/// @param[in] other
+	/// The tree to compare against, e.g. a tree previously
+	/// saved with `writeTo()` and loaded with `readFrom()`.
+	///
+	/// @param[in] visitor
+	/// A function, or function object, that is called with the index
+	/// of each differing block, in ascending order.
+	template<typename Visitor>
+	void compare(const Arduboy2EEPROMHashIndex & other, Visitor && visitor) const
+	{
+		compareNode(other, 1, visitor);
+	}
+
+	/// @brief
+	/// Writes the tree to EEPROM.
+	///
+	/// @param[in] address
+	/// The address at which the tree is to be written.
+	///
+	/// @pre
+	/// @li The range of `storageSize` bytes starting at `address`
+	/// **must not** overlap the indexed region.
+	///
+	/// @note
+	/// If the indexed region is the whole of EEPROM (the default),
+	/// there is nowhere to write the tree that satisfies the above,
+	/// and it must be kept in RAM or persisted by the host instead.
+	void writeTo(uintptr_t address) const
+	{
+		EEPROM::write(address, reinterpret_cast<const unsigned char *>(&nodes[1]), storageSize);
+	}
+
+	/// @brief
+	/// Reads a tree previously written with `writeTo()`.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `blockCount`.
+	///
+	/// @param[in] address
+	/// The address of the tree.
+	///
+	/// @retval true The stored tree was intact.
+	/// @retval false The stored tree was damaged, and the contents of
+	/// the tree are unspecified until `rebuild()` is called,
+	/// or the address policy rejected the range of `storageSize` bytes
+	/// starting at `address`, in which case nothing was read.
+	///
+	/// @details
+	/// The internal nodes are recalculated from the stored leaves,
+	/// and the result is compared with the stored root, thus damage to
+	/// the root or to any leaf is detected, whilst damage to any other
+	/// node is simply repaired.
+	///
+	/// @note
+	/// No blocks are rehashed, and any blocks previously
+	/// recorded as modified are forgotten.
+	bool readFrom(uintptr_t address)
+	{
+		// The range is checked once, rather than for each node
+		const typename EEPROM::ConstView stored = EEPROM::view(address, storageSize);
+
+		if(stored.size() != storageSize)
+			return false;
+
+		stored.copyTo(reinterpret_cast<unsigned char *>(&nodes[1]));
+
+		for(size_t index = 0; index < sizeof(modified); ++index)
+			modified[index] = 0;
+
+		const HashType storedRoot = nodes[1];
+
+		for(size_t node = (blockCount - 1); node > 0; --node)
+			hashChildren(node);
+
+		return (nodes[1] == storedRoot);
+	}
+};
+
+// Definitions of the static member constants,
+// required prior to C++17 if they are odr-used
+template<typename EEPROM, size_t indexBlockSize, uintptr_t indexAddress, size_t indexSize>
+constexpr size_t Arduboy2EEPROMHashIndex<EEPROM, indexBlockSize, indexAddress, indexSize>::blockSize;
+
+template<typename EEPROM, size_t indexBlockSize, uintptr_t indexAddress, size_t indexSize>
+constexpr size_t Arduboy2EEPROMHashIndex<EEPROM, indexBlockSize, indexAddress, indexSize>::blockCount;
+
+template<typename EEPROM, size_t indexBlockSize, uintptr_t indexAddress, size_t indexSize>
+constexpr size_t Arduboy2EEPROMHashIndex<EEPROM, indexBlockSize, indexAddress, indexSize>::storageSize;
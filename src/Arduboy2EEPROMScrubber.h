@@ -0,0 +1,328 @@
+#pragma once
+
+/// @file Arduboy2EEPROMScrubber.h
+/// @brief The `Arduboy2EEPROMScrubber` class template.
+/// @details Incrementally re-verifies hashed records during idle time.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t, uint8_t, uint16_t
+#include <stdint.h>
+
+/// @brief
+/// The state of a record, as last determined by an `Arduboy2EEPROMScrubber`.
+enum class Arduboy2EEPROMRecordState : uint8_t
+{
+	/// @brief
+	/// The record has not yet been checked.
+	Unchecked,
+
+	/// @brief
+	/// The record's hash code matched when it was last checked.
+	Intact,
+
+	/// @brief
+	/// The record was damaged, and has been restored from its backup.
+	/// This state is kept by later checks that find the record intact,
+	/// until a write to the record is reported.
+	Repaired,
+
+	/// @brief
+	/// The record was damaged, and could not be restored.
+	Damaged,
+};
+
+/// @brief
+/// Walks a registry of records written with `writeWithHash()`,
+/// rehashing a few bytes at a time, so that damaged records are
+/// discovered before a player next tries to load them.
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @tparam maximumRecords
+/// The maximum number of records that can be registered.
+///
+/// @details
+/// Records are registered with `add()`, optionally along with the
+/// address of a redundant copy written with `writeWithHash()`.
+/// Each call to `tick()` hashes at most the specified number of bytes,
+/// thus the time spent per call is bounded and `tick()` can be called
+/// once per frame, or whenever the program would otherwise be idle.
+///
+/// When a record's hash code does not match, the record is restored
+/// from its backup if the backup is intact, and is otherwise
+/// marked as damaged so that the program can warn the player.
+///
+/// Damage is detected within two passes over every record,
+/// where a pass takes `(totalSize / byteBudget)` calls to `tick()`,
+/// rounded up, and `totalSize` is the sum of the sizes of the records.
+/// More precisely, damage to a byte that has just been hashed is only
+/// found once its record is next finished, thus the worst case is
+/// `((totalSize + largestSize - 1) / byteBudget)` calls, rounded up,
+/// where `largestSize` is the size of the largest record.
+/// This is measured by `extras/simulation/ScrubberBitRot.cpp`.
+///
+/// To scrub a backup as well, register it as a record of its own,
+/// with the original as its backup.
+///
+/// @warning
+/// A record written whilst it is part-way through being checked
+/// would appear damaged, and would then be restored from its backup,
+/// undoing the write. Every write to a registered record **must**
+/// therefore be reported with `markWritten()`.
+template<typename EEPROM, size_t maximumRecords = 4>
+class Arduboy2EEPROMScrubber
+{
+public:
+	/// @brief
+	/// The type of the stored hash codes.
+	using HashType = typename EEPROM::HashType;
+
+	/// @brief
+	/// The maximum number of records that can be registered.
+	static constexpr size_t recordCapacity = maximumRecords;
+
+	/// @brief
+	/// Indicates that a record has no backup.
+	static constexpr uintptr_t noBackup = ~static_cast<uintptr_t>(0);
+
+	static_assert(maximumRecords > 0, "The registry must be able to hold at least one record");
+
+private:
+	struct Record
+	{
+		uintptr_t address;
+		uintptr_t backupAddress;
+		size_t size;
+		Arduboy2EEPROMRecordState state;
+	};
+
+	Record records[maximumRecords];
+	size_t count = 0;
+
+	// The record being checked, the number of its bytes
+	// hashed so far, and the hash code of those bytes
+	size_t currentRecord = 0;
+	size_t currentOffset = 0;
+	HashType currentHash = EEPROM::emptyHash;
+
+	uint16_t passes = 0;
+	uint16_t repairs = 0;
+
+	static bool overlaps(uintptr_t address, size_t size, const Record & record)
+	{
+		const size_t recordSize = (sizeof(HashType) + record.size);
+
+		return ((address < (record.address + recordSize)) && (record.address < (address + size)));
+	}
+
+	// Returns true if the record was restored from its backup
+	bool finish(Record & record)
+	{
+		HashType storedHash {};
+		EEPROM::read(record.address, storedHash);
+
+		if(storedHash == currentHash)
+		{
+			// A repair remains visible until the record is next written
+			if(record.state != Arduboy2EEPROMRecordState::Repaired)
+				record.state = Arduboy2EEPROMRecordState::Intact;
+
+			return false;
+		}
+
+		if((record.backupAddress != noBackup) && EEPROM::copyWithHash(record.address, record.backupAddress, record.size))
+		{
+			record.state = Arduboy2EEPROMRecordState::Repaired;
+			++repairs;
+			return true;
+		}
+
+		record.state = Arduboy2EEPROMRecordState::Damaged;
+		return false;
+	}
+
+public:
+	/// @brief
+	/// Registers a record to be checked.
+	///
+	/// @param[in] address
+	/// The address of the record, as passed to `writeWithHash()`.
+	///
+	/// @param[in] size
+	/// The size of the stored object, excluding its hash code.
+	///
+	/// @param[in] backupAddress
+	/// The address of a redundant copy of the record,
+	/// or `noBackup` if there is none.
+	///
+	/// @retval true The record was registered.
+	/// @retval false The registry is full, or `size` is `0`.
+	bool add(uintptr_t address, size_t size, uintptr_t backupAddress = noBackup)
+	{
+		if((count >= maximumRecords) || (size == 0))
+			return false;
+
+		records[count] = Record { address, backupAddress, size, Arduboy2EEPROMRecordState::Unchecked };
+		++count;
+
+		return true;
+	}
+
+	/// @brief
+	/// Registers a record of type `Type` to be checked.
+	///
+	/// @see add(uintptr_t, size_t, uintptr_t)
+	template<typename Type>
+	bool add(uintptr_t address, uintptr_t backupAddress = noBackup)
+	{
+		return add(address, sizeof(Type), backupAddress);
+	}
+
+	/// @brief
+	/// Reports that a range of bytes has been written to.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `recordCount()`.
+	///
+	/// @details
+	/// Records that overlap the range are marked as unchecked,
+	/// and if the record currently being checked is among them,
+	/// its check is restarted.
+	void markWritten(uintptr_t address, size_t size)
+	{
+		for(size_t index = 0; index < count; ++index)
+		{
+			if(!overlaps(address, size, records[index]))
+				continue;
+
+			records[index].state = Arduboy2EEPROMRecordState::Unchecked;
+
+			if(index == currentRecord)
+			{
+				currentOffset = 0;
+				currentHash = EEPROM::emptyHash;
+			}
+		}
+	}
+
+	/// @brief
+	/// Continues checking records.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `byteBudget`, except when a damaged record
+	/// is restored from its backup, which additionally costs `O(m)`,
+	/// where `m` is the size of the record.
+	///
+	/// @param[in] byteBudget
+	/// The maximum number of bytes to hash during this call.
+	///
+	/// @retval true A record was restored from its backup.
+	/// If the EEPROM implementation requires it, `commit()`
+	/// should be called to make the restoration permanent.
+	/// @retval false No record was restored.
+	bool tick(size_t byteBudget)
+	{
+		bool repaired = false;
+
+		while((count > 0) && (byteBudget > 0))
+		{
+			Record & record = records[currentRecord];
+
+			const size_t remaining = (record.size - currentOffset);
+			const size_t step = ((remaining < byteBudget) ? remaining : byteBudget);
+			const uintptr_t objectAddress = (record.address + sizeof(HashType));
+
+			for(size_t index = 0; index < step; ++index)
+				currentHash = EEPROM::hashByte(currentHash, EEPROM::readByte(objectAddress + currentOffset + index));
+
+			currentOffset += step;
+			byteBudget -= step;
+
+			if(currentOffset < record.size)
+				break;
+
+			if(finish(record))
+				repaired = true;
+
+			currentOffset = 0;
+			currentHash = EEPROM::emptyHash;
+
+			++currentRecord;
+
+			if(currentRecord == count)
+			{
+				currentRecord = 0;
+				++passes;
+			}
+		}
+
+		return repaired;
+	}
+
+	/// @brief
+	/// Returns the number of registered records.
+	size_t recordCount() const
+	{
+		return count;
+	}
+
+	/// @brief
+	/// Returns the state of a record, as of its most recent check.
+	///
+	/// @param[in] index
+	/// The index of the record, in the order in which records were added.
+	///
+	/// @pre
+	/// @li `(index < recordCount())`
+	Arduboy2EEPROMRecordState recordState(size_t index) const
+	{
+		return records[index].state;
+	}
+
+	/// @brief
+	/// Determines whether any record was found to be damaged
+	/// and could not be restored.
+	bool hasDamage() const
+	{
+		for(size_t index = 0; index < count; ++index)
+			if(records[index].state == Arduboy2EEPROMRecordState::Damaged)
+				return true;
+
+		return false;
+	}
+
+	/// @brief
+	/// Returns the number of times a record has been restored
+	/// from its backup.
+	///
+	/// @note
+	/// Unlike `recordState()`, this is not reset by `markWritten()`,
+	/// thus a program can tell whether any repair has ever been made.
+	/// The count wraps around to `0` after `65535`.
+	uint16_t repairCount() const
+	{
+		return repairs;
+	}
+
+	/// @brief
+	/// Returns the number of complete passes over every record.
+	///
+	/// @note
+	/// The count wraps around to `0` after `65535`.
+	uint16_t passCount() const
+	{
+		return passes;
+	}
+};
+
+// Definitions of the static member constants,
+// required prior to C++17 if they are odr-used
+template<typename EEPROM, size_t maximumRecords>
+constexpr size_t Arduboy2EEPROMScrubber<EEPROM, maximumRecords>::recordCapacity;
+
+template<typename EEPROM, size_t maximumRecords>
+constexpr uintptr_t Arduboy2EEPROMScrubber<EEPROM, maximumRecords>::noBackup;
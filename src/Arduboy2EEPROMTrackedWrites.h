@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file Arduboy2EEPROMTrackedWrites.h
+/// @brief The `Arduboy2EEPROMTrackedWrites` class template.
+/// @details Forwards write operations to an EEPROM API and reports the bytes they wrote.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t
+#include <stdint.h>
+
+/// @brief
+/// A base class that provides each write operation of an EEPROM API,
+/// and reports every range of bytes that it writes to the derived class.
+///
+/// @tparam Derived
+/// The class that derives from this class, which must provide
+/// a member function `void onWritten(uintptr_t address, size_t size)`,
+/// accessible to this class.
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @details
+/// Each write operation is forwarded to `EEPROM`, then `onWritten()`
+/// is called with the address and size of each range it wrote to.
+/// Ranges are reported exactly as passed to `EEPROM`, i.e. before
+/// the address policy is applied, thus `onWritten()` must allow
+/// for ranges that do not lie within EEPROM.
+///
+/// @see Arduboy2EEPROMHashIndex
+/// @see Arduboy2EEPROMVerificationCache
+template<typename Derived, typename EEPROM>
+class Arduboy2EEPROMTrackedWrites
+{
+private:
+	void written(uintptr_t address, size_t size)
+	{
+		static_cast<Derived &>(*this).onWritten(address, size);
+	}
+
+public:
+	/// @brief
+	/// Writes a single byte to EEPROM.
+	///
+	/// @see EEPROM::writeByte()
+	void writeByte(uintptr_t address, unsigned char byte)
+	{
+		EEPROM::writeByte(address, byte);
+		written(address, 1);
+	}
+
+	/// @brief
+	/// Clears bits of a byte in EEPROM.
+	///
+	/// @see EEPROM::clearBits()
+	void clearBits(uintptr_t address, unsigned char mask)
+	{
+		EEPROM::clearBits(address, mask);
+		written(address, 1);
+	}
+
+	/// @brief
+	/// Writes a range of bytes to EEPROM.
+	///
+	/// @see EEPROM::write()
+	void write(uintptr_t address, const unsigned char * data, size_t size)
+	{
+		EEPROM::write(address, data, size);
+		written(address, size);
+	}
+
+	/// @brief
+	/// Writes an object to EEPROM.
+	///
+	/// @see EEPROM::write()
+	template<typename Type>
+	void write(uintptr_t address, const Type & object)
+	{
+		EEPROM::write(address, object);
+		written(address, sizeof(object));
+	}
+
+	/// @brief
+	/// Sets a range of bytes to the same value.
+	///
+	/// @see EEPROM::fill()
+	void fill(uintptr_t address, unsigned char value, size_t size)
+	{
+		EEPROM::fill(address, value, size);
+		written(address, size);
+	}
+
+	/// @brief
+	/// Erases a range of bytes.
+	///
+	/// @see EEPROM::erase()
+	void erase(uintptr_t address, size_t size)
+	{
+		EEPROM::erase(address, size);
+		written(address, size);
+	}
+
+	/// @brief
+	/// Copies a range of bytes within EEPROM.
+	///
+	/// @see EEPROM::copy()
+	void copy(uintptr_t destination, uintptr_t source, size_t size)
+	{
+		EEPROM::copy(destination, source, size);
+		written(destination, size);
+	}
+
+	/// @brief
+	/// Copies a range of bytes within EEPROM,
+	/// correctly handling ranges that overlap.
+	///
+	/// @see EEPROM::move()
+	void move(uintptr_t destination, uintptr_t source, size_t size)
+	{
+		EEPROM::move(destination, source, size);
+		written(destination, size);
+	}
+
+	/// @brief
+	/// Exchanges the contents of two ranges of bytes.
+	///
+	/// @see EEPROM::swap()
+	void swap(uintptr_t first, uintptr_t second, size_t size)
+	{
+		EEPROM::swap(first, second, size);
+		written(first, size);
+		written(second, size);
+	}
+
+	/// @brief
+	/// Writes both an object and a hash code to EEPROM.
+	///
+	/// @see EEPROM::writeWithHash()
+	template<typename Type>
+	void writeWithHash(uintptr_t address, const Type & object)
+	{
+		EEPROM::writeWithHash(address, object);
+		written(address, (sizeof(typename EEPROM::HashType) + sizeof(object)));
+	}
+
+	/// @brief
+	/// Writes both an object and a hash code to EEPROM,
+	/// using a custom hash provider.
+	///
+	/// @see EEPROM::writeWithHash()
+	template<typename Hash, typename Type>
+	void writeWithHash(uintptr_t address, const Type & object, Hash && hash)
+	{
+		using CustomHashType = decltype(hash(object));
+
+		EEPROM::writeWithHash(address, object, static_cast<Hash &&>(hash));
+		written(address, (sizeof(CustomHashType) + sizeof(object)));
+	}
+
+	/// @brief
+	/// Copies a record written with `writeWithHash()`,
+	/// provided that the record is intact.
+	///
+	/// @see EEPROM::copyWithHash()
+	bool copyWithHash(uintptr_t destination, uintptr_t source, size_t size)
+	{
+		if(!EEPROM::copyWithHash(destination, source, size))
+			return false;
+
+		written(destination, (sizeof(typename EEPROM::HashType) + size));
+		return true;
+	}
+
+	/// @brief
+	/// Copies a record of type `Type` written with `writeWithHash()`,
+	/// provided that the record is intact.
+	///
+	/// @see EEPROM::copyWithHash()
+	template<typename Type>
+	bool copyWithHash(uintptr_t destination, uintptr_t source)
+	{
+		return copyWithHash(destination, source, sizeof(Type));
+	}
+
+	/// @brief
+	/// Writes an object to EEPROM along with chunk and summary hash codes.
+	///
+	/// @see EEPROM::writeWithChunkedHash()
+	template<size_t chunkSize, typename Type>
+	void writeWithChunkedHash(uintptr_t address, const Type & object)
+	{
+		EEPROM::template writeWithChunkedHash<chunkSize>(address, object);
+		written(address, EEPROM::chunkedHashSize(sizeof(object), chunkSize));
+	}
+};
@@ -0,0 +1,295 @@
+#pragma once
+
+/// @file Arduboy2EEPROMVerificationCache.h
+/// @brief The `Arduboy2EEPROMVerificationCache` class template.
+/// @details Remembers which hashed records have been verified since they were last written.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t and uint16_t
+#include <stdint.h>
+
+// For Arduboy2EEPROMTrackedWrites
+#include "Arduboy2EEPROMTrackedWrites.h"
+
+/// @brief
+/// A cache of the results of `readWithHash()`, which allows
+/// records that have not been written to since they were last
+/// verified to be read again without being rehashed.
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @tparam cacheRegionSize
+/// The number of bytes covered by each generation counter.
+///
+/// @tparam cacheEntryCount
+/// The maximum number of verified records to remember.
+///
+/// @details
+/// EEPROM is divided into fixed-size regions, each with a generation
+/// counter that records when the region was last written to.
+/// The counters are stamped from a single clock that advances upon
+/// every write, thus a record spanning several regions was unmodified
+/// since it was verified if none of its regions have a generation
+/// later than that of the verification.
+///
+/// Write operations **must** be made through the cache (which provides
+/// those of `Arduboy2EEPROMTrackedWrites`), or reported with `markWritten()`.
+/// Reads may be made through `EEPROM` directly as usual.
+///
+/// When the cache is full, the oldest remembered record is forgotten.
+///
+/// @note
+/// The cache is only ever a shortcut: a record that is not found in
+/// the cache, or that has been written to, is simply rehashed.
+///
+/// @warning
+/// The cache can only observe writes made through it.
+/// Changes made to EEPROM by any other means, such as by a failing
+/// cell or by another program, go unnoticed until the affected record
+/// is rehashed, e.g. after a call to `clear()`.
+template<typename EEPROM, size_t cacheRegionSize = 64, size_t cacheEntryCount = 4>
+class Arduboy2EEPROMVerificationCache : public Arduboy2EEPROMTrackedWrites<Arduboy2EEPROMVerificationCache<EEPROM, cacheRegionSize, cacheEntryCount>, EEPROM>
+{
+public:
+	/// @brief
+	/// The type of the stored hash codes.
+	using HashType = typename EEPROM::HashType;
+
+	/// @brief
+	/// The type of the generation counters.
+	using GenerationType = uint16_t;
+
+	/// @brief
+	/// The number of bytes covered by each generation counter.
+	static constexpr size_t regionSize = cacheRegionSize;
+
+	/// @brief
+	/// The number of generation counters.
+	static constexpr size_t regionCount = ((EEPROM::capacity + (cacheRegionSize - 1)) / cacheRegionSize);
+
+	/// @brief
+	/// The maximum number of verified records remembered at once.
+	static constexpr size_t entryCount = cacheEntryCount;
+
+	static_assert(cacheRegionSize > 0, "Region size must not be zero");
+	static_assert(cacheEntryCount > 0, "The cache must have at least one entry");
+
+private:
+	struct Entry
+	{
+		uintptr_t address;
+		size_t size;
+
+		// Zero marks an unused entry
+		GenerationType generation;
+	};
+
+	// The generation at which each region was last written to
+	GenerationType regionGenerations[regionCount];
+
+	// The clock from which generations are stamped
+	GenerationType generation;
+
+	Entry entries[entryCount];
+
+	// The entry to be replaced next
+	size_t nextEntry;
+
+	friend class Arduboy2EEPROMTrackedWrites<Arduboy2EEPROMVerificationCache, EEPROM>;
+
+	// Called after each write made through the cache
+	void onWritten(uintptr_t address, size_t size)
+	{
+		markWritten(address, size);
+	}
+
+	void advance()
+	{
+		++generation;
+
+		// Once the clock wraps around, generations can no longer
+		// be compared, so everything is forgotten and the clock restarts
+		if(generation == 0)
+			clear();
+	}
+
+	bool isVerified(uintptr_t address, size_t size) const
+	{
+		for(size_t index = 0; index < entryCount; ++index)
+		{
+			const Entry & entry = entries[index];
+
+			if((entry.generation == 0) || (entry.address != address) || (entry.size != size))
+				continue;
+
+			const size_t firstRegion = (address / regionSize);
+			const size_t lastRegion = ((address + size - 1) / regionSize);
+
+			for(size_t region = firstRegion; region <= lastRegion; ++region)
+				if(regionGenerations[region] > entry.generation)
+					return false;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	static bool isWithinEEPROM(uintptr_t address, size_t size)
+	{
+		return ((address <= EEPROM::capacity) && (size <= (EEPROM::capacity - address)));
+	}
+
+	void remember(uintptr_t address, size_t size)
+	{
+		// A record that does not lie within EEPROM (e.g. one that the
+		// address policy wraps around) would span regions that do not
+		// exist, so it is simply never remembered
+		if(!isWithinEEPROM(address, size))
+			return;
+
+		// Reuse the record's existing entry, if it has one
+		for(size_t index = 0; index < entryCount; ++index)
+		{
+			Entry & entry = entries[index];
+
+			if((entry.generation != 0) && (entry.address == address) && (entry.size == size))
+			{
+				entry.generation = generation;
+				return;
+			}
+		}
+
+		entries[nextEntry] = Entry { address, size, generation };
+		nextEntry = ((nextEntry + 1) % entryCount);
+	}
+
+public:
+	/// @brief
+	/// Constructs an empty cache.
+	Arduboy2EEPROMVerificationCache()
+	{
+		clear();
+	}
+
+	/// @brief
+	/// Forgets every verified record.
+	///
+	/// @par Complexity
+	/// `O(n + m)`, where `n` is `regionCount`
+	/// and `m` is `entryCount`.
+	void clear()
+	{
+		for(size_t region = 0; region < regionCount; ++region)
+			regionGenerations[region] = 0;
+
+		for(size_t index = 0; index < entryCount; ++index)
+			entries[index].generation = 0;
+
+		generation = 1;
+		nextEntry = 0;
+	}
+
+	/// @brief
+	/// Records that a range of bytes has been written to,
+	/// invalidating any verified records that overlap it.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is the number of regions the range overlaps.
+	///
+	/// @param[in] address
+	/// The address of the first byte that was written.
+	///
+	/// @param[in] size
+	/// The number of contiguous bytes that were written.
+	///
+	/// @note
+	/// A range that does not lie entirely within EEPROM invalidates
+	/// every verified record, since the address policy may have
+	/// redirected the write anywhere (e.g. by wrapping it).
+	void markWritten(uintptr_t address, size_t size)
+	{
+		if(size == 0)
+			return;
+
+		advance();
+
+		if(!isWithinEEPROM(address, size))
+		{
+			for(size_t region = 0; region < regionCount; ++region)
+				regionGenerations[region] = generation;
+
+			return;
+		}
+
+		const uintptr_t end = (address + size);
+
+		const size_t firstRegion = (address / regionSize);
+		const size_t lastRegion = ((end - 1) / regionSize);
+
+		for(size_t region = firstRegion; region <= lastRegion; ++region)
+			regionGenerations[region] = generation;
+	}
+
+	/// @brief
+	/// Reads both an object and a hash code from EEPROM,
+	/// and determines if the hash of the object matches
+	/// the stored hash code, unless the record has already
+	/// been verified and not written to since.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `sizeof(object)`,
+	/// but without the cost of hashing the object
+	/// if the record is found in the cache.
+	///
+	/// @param[in] address
+	/// The address of the hash code and object to be read.
+	///
+	/// @param[out] object
+	/// A reference to an object that shall receive the data
+	/// read from EEPROM.
+	///
+	/// @retval true The hash of the stored object matched the stored hash code.
+	/// @retval false The hash code did not match.
+	///
+	/// @pre
+	/// The same as those of `EEPROM::readWithHash()`.
+	///
+	/// @note
+	/// Only successful verifications are remembered,
+	/// thus a damaged record is rehashed every time it is read.
+	///
+	/// @see EEPROM::readWithHash()
+	template<typename Type>
+	bool readWithHash(uintptr_t address, Type & object)
+	{
+		const size_t size = (sizeof(HashType) + sizeof(object));
+
+		if(isVerified(address, size))
+		{
+			EEPROM::read(address + sizeof(HashType), object);
+			return true;
+		}
+
+		if(!EEPROM::readWithHash(address, object))
+			return false;
+
+		remember(address, size);
+		return true;
+	}
+};
+
+// Definitions of the static member constants,
+// required prior to C++17 if they are odr-used
+template<typename EEPROM, size_t cacheRegionSize, size_t cacheEntryCount>
+constexpr size_t Arduboy2EEPROMVerificationCache<EEPROM, cacheRegionSize, cacheEntryCount>::regionSize;
+
+template<typename EEPROM, size_t cacheRegionSize, size_t cacheEntryCount>
+constexpr size_t Arduboy2EEPROMVerificationCache<EEPROM, cacheRegionSize, cacheEntryCount>::regionCount;
+
+template<typename EEPROM, size_t cacheRegionSize, size_t cacheEntryCount>
+constexpr size_t Arduboy2EEPROMVerificationCache<EEPROM, cacheRegionSize, cacheEntryCount>::entryCount;
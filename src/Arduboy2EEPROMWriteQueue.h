@@ -0,0 +1,401 @@
+#pragma once
+
+/// @file Arduboy2EEPROMWriteQueue.h
+/// @brief The `Arduboy2EEPROMWriteQueue` class template.
+/// @details Spreads the writing of records across frames, most important first.
+/// @author [Pharap](https://github.com/Pharap)
+
+// For size_t
+#include <stddef.h>
+
+// For uintptr_t, uint8_t, int32_t, uint32_t
+#include <stdint.h>
+
+/// @brief
+/// A queue of pending writes, drained a few bytes at a time,
+/// so that important records (e.g. progress) are made durable
+/// before less important ones (e.g. settings).
+///
+/// @tparam EEPROM
+/// The EEPROM API to use, e.g. `Arduboy2EEPROM`.
+///
+/// @tparam maximumEntries
+/// The maximum number of writes that can be pending at once.
+///
+/// @tparam priorityLevels
+/// The number of distinct priorities.
+///
+/// @details
+/// Each write is of an object in RAM, enqueued with the address at which
+/// it is to be saved, a priority and a deadline.
+/// Each call to `drain()` writes at most the specified number of bytes,
+/// thus the time spent per call is bounded and `drain()` can be called
+/// once per frame. A write may span several calls to `drain()`.
+///
+/// Pending writes are drained in order of:
+/// @li Whether the deadline has passed, overdue writes first.
+/// @li Priority, higher priorities first.
+/// @li Deadline, earliest first.
+///
+/// Records are saved in the same format as `writeWithHash()`,
+/// with the hash code written last, and can be loaded with `readWithHash()`.
+/// Until a write is complete, the record's hash code will not match.
+///
+/// Times are given by the program, in any unit, e.g. by `millis()`.
+/// Only differences between times are used, thus times may wrap around,
+/// provided deadlines are less than half the range of `TimeType` away.
+///
+/// @warning
+/// An enqueued object **must** remain alive, and at the same location,
+/// until it has been written. If it changes before then,
+/// it **must** be enqueued again. The write then continues where it
+/// was, and any bytes already written that have since changed
+/// are rewritten when the write completes.
+template<typename EEPROM, size_t maximumEntries = 4, uint8_t priorityLevels = 2>
+class Arduboy2EEPROMWriteQueue
+{
+public:
+	/// @brief
+	/// The type used for times.
+	using TimeType = uint32_t;
+
+	/// @brief
+	/// The type of the stored hash codes.
+	using HashType = typename EEPROM::HashType;
+
+	/// @brief
+	/// The maximum number of writes that can be pending at once.
+	static constexpr size_t entryCapacity = maximumEntries;
+
+	/// @brief
+	/// The number of distinct priorities.
+	/// Valid priorities range from `0` (the lowest) to `(priorityCount - 1)`.
+	static constexpr uint8_t priorityCount = priorityLevels;
+
+	static_assert(maximumEntries > 0, "The queue must be able to hold at least one entry");
+	static_assert(priorityLevels > 0, "The queue must have at least one priority");
+
+private:
+	struct Entry
+	{
+		const unsigned char * data;
+		uintptr_t address;
+		size_t size;
+
+		TimeType enqueueTime;
+		TimeType deadline;
+		uint8_t priority;
+
+		// The number of bytes written so far,
+		// and the hash code of those bytes
+		size_t offset;
+		HashType hash;
+
+		// The number of bytes that had been written when the object
+		// was last enqueued again, which may no longer match it
+		size_t staleSize;
+	};
+
+	struct Statistics
+	{
+		uint32_t durableCount;
+		TimeType totalTimeToDurable;
+		TimeType maximumTimeToDurable;
+
+		// The most writes of the priority pending at once
+		size_t maximumDepth;
+	};
+
+	Entry entries[maximumEntries];
+	size_t count = 0;
+
+	Statistics statistics[priorityLevels] {};
+
+	static bool isOverdue(const Entry & entry, TimeType now)
+	{
+		return (static_cast<int32_t>(now - entry.deadline) >= 0);
+	}
+
+	// Determines whether the left entry should be written before the right
+	static bool precedes(const Entry & left, const Entry & right, TimeType now)
+	{
+		const bool leftOverdue = isOverdue(left, now);
+		const bool rightOverdue = isOverdue(right, now);
+
+		if(leftOverdue != rightOverdue)
+			return leftOverdue;
+
+		if(left.priority != right.priority)
+			return (left.priority > right.priority);
+
+		return (static_cast<int32_t>(left.deadline - right.deadline) < 0);
+	}
+
+	size_t findNext(TimeType now) const
+	{
+		size_t next = 0;
+
+		for(size_t index = 1; index < count; ++index)
+			if(precedes(entries[index], entries[next], now))
+				next = index;
+
+		return next;
+	}
+
+	void recordDepth(uint8_t priority)
+	{
+		size_t depth = 0;
+
+		for(size_t index = 0; index < count; ++index)
+			if(entries[index].priority == priority)
+				++depth;
+
+		Statistics & statistic = statistics[priority];
+
+		if(depth > statistic.maximumDepth)
+			statistic.maximumDepth = depth;
+	}
+
+	void complete(size_t index, TimeType now)
+	{
+		const Entry & entry = entries[index];
+
+		if(entry.staleSize > 0)
+		{
+			// Only the bytes that differ are rewritten,
+			// and the hash code of the earlier bytes is out of date
+			EEPROM::write(entry.address + sizeof(HashType), entry.data, entry.staleSize);
+			EEPROM::write(entry.address, EEPROM::hash(entry.data, entry.size));
+		}
+		else
+		{
+			EEPROM::write(entry.address, entry.hash);
+		}
+
+		Statistics & statistic = statistics[entry.priority];
+		const TimeType timeToDurable = (now - entry.enqueueTime);
+
+		++statistic.durableCount;
+		statistic.totalTimeToDurable += timeToDurable;
+
+		if(timeToDurable > statistic.maximumTimeToDurable)
+			statistic.maximumTimeToDurable = timeToDurable;
+
+		// Order is unimportant, so the last entry fills the gap
+		--count;
+		entries[index] = entries[count];
+	}
+
+public:
+	/// @brief
+	/// Enqueues an object to be written.
+	///
+	/// @par Complexity
+	/// `O(n)`, where `n` is `queueDepth()`.
+	///
+	/// @param[in] address
+	/// The address at which the object and its hash code are to be saved.
+	///
+	/// @param[in] object
+	/// The object to be written.
+	///
+	/// @param[in] priority
+	/// The priority of the write.
+	///
+	/// @param[in] deadline
+	/// The time by which the write should be complete.
+	///
+	/// @param[in] now
+	/// The current time.
+	///
+	/// @retval true The write was enqueued.
+	/// @retval false The queue is full.
+	///
+	/// @note
+	/// A `priority` greater than `(priorityCount - 1)`
+	/// is treated as `(priorityCount - 1)`.
+	///
+	/// @details
+	/// If a write to the same address is already pending, it is updated
+	/// with the given object, keeping the higher of the two priorities,
+	/// the earlier of the two deadlines and the original enqueue time.
+	/// The write continues from where it was, so that an object
+	/// that changes every frame is still written eventually.
+	/// When it completes, the bytes written before this call are
+	/// compared with the object, and those that differ are rewritten,
+	/// thus completing may write up to `sizeof(object)` bytes
+	/// beyond the byte budget of `drain()`.
+	/// If the size of the object differs, the write is restarted.
+	template<typename Type>
+	bool enqueue(uintptr_t address, const Type & object, uint8_t priority, TimeType deadline, TimeType now)
+	{
+		const unsigned char * data = reinterpret_cast<const unsigned char *>(&object);
+
+		if(priority >= priorityLevels)
+			priority = (priorityLevels - 1);
+
+		for(size_t index = 0; index < count; ++index)
+		{
+			Entry & entry = entries[index];
+
+			if(entry.address != address)
+				continue;
+
+			entry.data = data;
+
+			if(entry.size == sizeof(object))
+			{
+				entry.staleSize = entry.offset;
+			}
+			else
+			{
+				entry.size = sizeof(object);
+				entry.offset = 0;
+				entry.hash = EEPROM::emptyHash;
+				entry.staleSize = 0;
+			}
+
+			if(priority > entry.priority)
+			{
+				entry.priority = priority;
+				recordDepth(priority);
+			}
+
+			if(static_cast<int32_t>(deadline - entry.deadline) < 0)
+				entry.deadline = deadline;
+
+			return true;
+		}
+
+		if(count >= maximumEntries)
+			return false;
+
+		entries[count] = Entry { data, address, sizeof(object), now, deadline, priority, 0, EEPROM::emptyHash, 0 };
+		++count;
+
+		recordDepth(priority);
+
+		return true;
+	}
+
+	/// @brief
+	/// Continues writing pending objects.
+	///
+	/// @par Complexity
+	/// `O(n * m)`, where `n` is `queueDepth()` and `m` is the number of
+	/// writes completed during this call, plus `O(b)`, where `b` is `byteBudget`.
+	///
+	/// @param[in] now
+	/// The current time.
+	///
+	/// @param[in] byteBudget
+	/// The maximum number of bytes to write during this call,
+	/// excluding hash codes.
+	///
+	/// @retval true At least one write was completed.
+	/// If the EEPROM implementation requires it,
+	/// `commit()` should then be called.
+	/// @retval false No write was completed.
+	///
+	/// @note
+	/// Each byte written to the Arduboy's EEPROM takes up to about 3.4ms,
+	/// thus the byte budget also bounds the time spent,
+	/// except when completing a write whose object was enqueued again
+	/// (see `enqueue()`).
+	bool drain(TimeType now, size_t byteBudget)
+	{
+		bool completed = false;
+
+		while(count > 0)
+		{
+			const size_t next = findNext(now);
+			Entry & entry = entries[next];
+
+			const uintptr_t objectAddress = (entry.address + sizeof(HashType));
+
+			while((entry.offset < entry.size) && (byteBudget > 0))
+			{
+				const unsigned char byte = entry.data[entry.offset];
+
+				EEPROM::writeByte(objectAddress + entry.offset, byte);
+				entry.hash = EEPROM::hashByte(entry.hash, byte);
+
+				++entry.offset;
+				--byteBudget;
+			}
+
+			if(entry.offset < entry.size)
+				break;
+
+			complete(next, now);
+			completed = true;
+		}
+
+		return completed;
+	}
+
+	/// @brief
+	/// Returns the number of pending writes.
+	size_t queueDepth() const
+	{
+		return count;
+	}
+
+	/// @brief
+	/// Returns the number of completed writes of a given priority.
+	///
+	/// @pre
+	/// @li `(priority < priorityCount)`
+	uint32_t durableCount(uint8_t priority) const
+	{
+		return statistics[priority].durableCount;
+	}
+
+	/// @brief
+	/// Returns the sum of the times taken, from being enqueued to being
+	/// completed, by the completed writes of a given priority.
+	///
+	/// @pre
+	/// @li `(priority < priorityCount)`
+	///
+	/// @note
+	/// Dividing by `durableCount(priority)` gives the average time.
+	TimeType totalTimeToDurable(uint8_t priority) const
+	{
+		return statistics[priority].totalTimeToDurable;
+	}
+
+	/// @brief
+	/// Returns the longest time taken, from being enqueued to being
+	/// completed, by any completed write of a given priority.
+	///
+	/// @pre
+	/// @li `(priority < priorityCount)`
+	TimeType maximumTimeToDurable(uint8_t priority) const
+	{
+		return statistics[priority].maximumTimeToDurable;
+	}
+
+	/// @brief
+	/// Returns the largest number of writes of a given priority
+	/// that have been pending at once.
+	///
+	/// @pre
+	/// @li `(priority < priorityCount)`
+	///
+	/// @note
+	/// A write whose priority is raised by enqueueing it again
+	/// is counted at its new priority from then on.
+	size_t maximumQueueDepth(uint8_t priority) const
+	{
+		return statistics[priority].maximumDepth;
+	}
+};
+
+// Definitions of the static member constants,
+// required prior to C++17 if they are odr-used
+template<typename EEPROM, size_t maximumEntries, uint8_t priorityLevels>
+constexpr size_t Arduboy2EEPROMWriteQueue<EEPROM, maximumEntries, priorityLevels>::entryCapacity;
+
+template<typename EEPROM, size_t maximumEntries, uint8_t priorityLevels>
+constexpr uint8_t Arduboy2EEPROMWriteQueue<EEPROM, maximumEntries, priorityLevels>::priorityCount;